@@ -0,0 +1,3 @@
+// This is a generated file, do not edit it!
+// lily-cc v0.2 (Fri Oct 16 03:35:37 UTC 2026)
+#include <pixie-16_config.h>
@@ -2,52 +2,70 @@
 #include "asm_postproc.h"
 #include "pixie-16_options.h"
 
-static inline void output_native_padd(FILE *fd, address_t n) {
-	char *buf = xalloc(global_alloc, 256);
-	memset(buf, 0, 256);
-	while (n > 256) {
-		// Write a bit at a time.
-		fwrite(buf, 1, 256, fd);
-		n -= 256;
+#include <unistd.h>
+#include <errno.h>
+
+// Runs of zeroes at least this long are left as holes in the output file.
+#define NATIVE_HOLE_MIN 4096
+
+// Writes the image, seeking past long runs of zeroes instead of writing them.
+// Outputs that can't seek, like pipes, get the zeroes written normally.
+// Returns true on success.
+static bool output_native_write(FILE *fd, const uint8_t *image, size_t len) {
+	if (ftell(fd) < 0) {
+		return fwrite(image, 1, len, fd) == len && !fflush(fd);
 	}
-	if (n) {
-		fwrite(buf, 1, n, fd);
+	size_t pos  = 0;
+	size_t scan = 0;
+	while (scan < len) {
+		// Find the next run of zeroes.
+		while (scan < len && image[scan]) scan++;
+		size_t zero = scan;
+		while (scan < len && !image[scan]) scan++;
+		if (scan - zero < NATIVE_HOLE_MIN) continue;
+		// Write the data before it and skip the zeroes.
+		if (fwrite(image + pos, 1, zero - pos, fd) != zero - pos) return false;
+		if (fseek(fd, scan - zero, SEEK_CUR)) return false;
+		pos = scan;
+	}
+	if (pos < len) {
+		if (fwrite(image + pos, 1, len - pos, fd) != len - pos) return false;
+	} else if (len) {
+		// Skipped zeroes at the end don't grow the file by themselves.
+		if (fflush(fd)) return false;
+		if (ftruncate(fileno(fd), ftell(fd))) {
+			if (fseek(fd, -1, SEEK_CUR) || fputc(0, fd) == EOF) return false;
+		}
 	}
-	xfree(global_alloc, buf);
+	// Buffered data can still fail to be written.
+	return !fflush(fd);
 }
 
 // Reduce: write everything we know as a chunk of machine code.
+// Chunks are written at their own address in the image, so they can be written in any order.
 static void output_native_reduce(asm_ctx_t *ctx, asm_sect_t *sect, uint8_t chunk_type, size_t chunk_len, uint8_t *chunk_data, void *args) {
-	fseek(ctx->out_fd, 0, SEEK_END);
-	long pos = ftell(ctx->out_fd);
-	if (pos >= 0 && pos < ctx->pc) {
-		output_native_padd(ctx->out_fd, ctx->pc - pos);
-	}
+	uint8_t *image = (uint8_t *) args + ctx->pc * sizeof(memword_t);
 	switch (chunk_type) {
 		case ASM_CHUNK_DATA: {
-			// Write the entire data immediately.
-			fwrite(chunk_data, 1, chunk_len, ctx->out_fd);
+			// Copy the entire data immediately.
+			memcpy(image, chunk_data, chunk_len);
 			ctx->pc += chunk_len / sizeof(memword_t);
 		} break;
 		case ASM_CHUNK_ZERO: {
-			// Write some zeroes.
+			// The image is already zeroed.
 			address_t n = asm_read_numb(chunk_data, sizeof(address_t));
-			output_native_padd(ctx->out_fd, n * sizeof(memword_t));
 			ctx->pc += n;
 		} break;
 		case ASM_CHUNK_LABEL_REF: {
 			// Get my label.
-			char buf[sizeof(memword_t) * ADDRESS_TO_MEMWORDS];
-			size_t len;
-			asm_ppc_label(ctx, chunk_data, buf, &len);
-			// Append it.
-			fwrite(buf, 1, len, ctx->out_fd);
+			size_t len = 0;
+			asm_ppc_label(ctx, chunk_data, image, &len);
 			ctx->pc += ADDRESS_TO_MEMWORDS;
 		} break;
 	}
 }
 
-void output_native(asm_ctx_t *ctx) {
+bool output_native(asm_ctx_t *ctx) {
     
     if (entrypoint) {
         // Insert entrypoints section.
@@ -124,9 +142,33 @@ void output_native(asm_ctx_t *ctx) {
 	// Pass 1: label resolution.
 	ctx->pc = 0;
 	asm_ppc_iterate(ctx, n_sect, sect_ids, sects, &asm_ppc_pass1, NULL, false);
+	if (ctx->pc_overflow) {
+		printf("\033[91mError: program does not fit in the address space, no output written.\033[0m\n");
+		xfree(ctx->allocator, sect_ids);
+		xfree(ctx->allocator, sects);
+		return false;
+	}
 	// Pass 2: binary generation (do not write .bss).
+	// The image is built in memory, sized from the section layout, and written all at once.
+	// Large zeroed regions become holes in the file.
+	size_t image_size = 0;
+	for (size_t i = 0; i < n_sect - 1; i++) {
+		size_t end = (sects[i]->offset + sects[i]->size) * sizeof(memword_t);
+		if (end > image_size) image_size = end;
+	}
+	uint8_t *image = xalloc(ctx->allocator, image_size);
+	memset(image, 0, image_size);
 	ctx->pc = 0;
-	asm_ppc_iterate(ctx, n_sect-1, sect_ids, sects, &output_native_reduce, NULL, true);
+	asm_ppc_iterate_parallel(ctx, n_sect-1, sect_ids, sects, &output_native_reduce, image);
+	if (!output_native_write(ctx->out_fd, image, image_size)) {
+		printf("\033[91mError: could not write the output: %s\033[0m\n", strerror(errno));
+		xfree(ctx->allocator, image);
+		xfree(ctx->allocator, sect_ids);
+		xfree(ctx->allocator, sects);
+		return false;
+	}
+	if (ctx->out_hexdump) asm_ppc_hexdump(ctx->out_hexdump, image, image_size);
+	xfree(ctx->allocator, image);
     // Pass 4: the optional addr2line file.
 	if (ctx->out_addr2line) {
 		ctx->pc = 0;
@@ -136,15 +178,16 @@ void output_native(asm_ctx_t *ctx) {
 	
 	// Enforce vector addresses.
 	if (entrypoint) {
-		asm_label_def_t *def = map_get(ctx->labels, "__px16_vectors.irq");
+		asm_label_def_t *def = asm_find_label(ctx, "__px16_vectors.irq");
 		if (def->address != 0) printf("\033[93mWarning: address of __px16_vectors.irq is not 0, your program might not work\033[0m\n");
-		def = map_get(ctx->labels, "__px16_vectors.nmi");
+		def = asm_find_label(ctx, "__px16_vectors.nmi");
 		if (def->address != 1) printf("\033[93mWarning: address of __px16_vectors.nmi is not 1, your program might not work.\033[0m\n");
-		def = map_get(ctx->labels, "__px16_vectors.entry");
+		def = asm_find_label(ctx, "__px16_vectors.entry");
 		if (def->address != 2) printf("\033[93mWarning: address of __px16_vectors.entry is not 2, your program might not work.\033[0m\n");
 	}
 	
     // Clean up.
     xfree(ctx->allocator, sect_ids);
     xfree(ctx->allocator, sects);
+    return true;
 }
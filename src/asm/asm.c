@@ -1,18 +1,18 @@
 
 #include "asm.h"
+#include "array_util.h"
 #include "ctxalloc_warn.h"
 #include <string.h>
 
 static inline asm_sect_t *asm_create_sect (asm_ctx_t  *ctx,  const char *id,   address_t align);
 static inline void        asm_align_sect  (asm_sect_t *sect, address_t   align);
 static        void        asm_append_chunk(asm_ctx_t  *ctx,  char        type);
-static inline void        asm_append_raw  (asm_ctx_t  *ctx,  const char *data, size_t len);
 static inline void        asm_append      (asm_ctx_t  *ctx,  const char *data, size_t len);
 
 // Initialises the context.
 void asm_init(asm_ctx_t *ctx) {
 	// Sections.
-	ctx->allocator   = alloc_create(ALLOC_NO_PARENT);
+	ctx->allocator   = alloc_create_arena(ALLOC_NO_PARENT);
 	ctx->sections    = (map_t *) xalloc(ctx->allocator, sizeof(map_t));
 	map_create(ctx->sections);
 	// Scopeth.
@@ -21,17 +21,25 @@ void asm_init(asm_ctx_t *ctx) {
 	ctx->global_scope.num       = 0;
 	ctx->global_scope.local_num = 0;
 	ctx->global_scope.allocator = ctx->allocator;
-	map_create(&ctx->global_scope.vars);
+	ctx->global_scope.undo_base = 0;
+	map_create(&ctx->symbols);
+	ctx->symbol_undo     = NULL;
+	ctx->symbol_undo_len = 0;
+	ctx->symbol_undo_cap = 0;
 	ctx->current_scope = &ctx->global_scope;
 	for (reg_t i = 0; i < NUM_REGS; i++) {
 		ctx->current_scope->reg_usage[i] = NULL;
 	}
 	// Labels.
 	ctx->last_global_label = NULL;
-	ctx->labels      = (map_t *) xalloc(ctx->allocator, sizeof(map_t));
-	map_create(ctx->labels);
+	ctx->label_defs      = NULL;
+	ctx->label_defs_len  = 0;
+	ctx->label_defs_cap  = 0;
+	map_create_by_content(&ctx->labels);
 	// Sections.
 	ctx->current_section_id = NULL;
+	ctx->pc_overflow        = false;
+	ctx->out_hexdump        = NULL;
 	// Compiled machine code
 	asm_use_sect   (ctx, ".text",   ASM_NOT_ALIGNED);
 	// Read-only initialised data
@@ -42,48 +50,80 @@ void asm_init(asm_ctx_t *ctx) {
 	asm_create_sect(ctx, ".bss",    ASM_NOT_ALIGNED);
 }
 
-// Append more data is the RAW way.
-static inline void asm_append_raw(asm_ctx_t *ctx, const char *data, size_t len) {
-	asm_sect_t *sect = ctx->current_section;
-	if (sect->chunks_capacity < sect->chunks_len + len) {
-		// Expand capacity.
-		sect->chunk_len = (size_t *) ((size_t) sect->chunk_len - (size_t) sect->chunks);
-		sect->chunks_capacity = sect->chunks_len + len + 128;
-		sect->chunks    = xrealloc(ctx->allocator, sect->chunks, sect->chunks_capacity);
-		sect->chunk_len = (size_t *) ((size_t) sect->chunk_len + (size_t) sect->chunks);
-	}
-	// Append data.
-	if (data) {
-		memcpy(sect->chunks + sect->chunks_len, data, len);
+// Adds a segment to the section, with room for at least min_cap bytes.
+static asm_chunk_seg_t *asm_add_seg(asm_ctx_t *ctx, asm_sect_t *sect, size_t min_cap) {
+	// Each segment is twice the size of the previous, up to a limit.
+	size_t cap = sect->last_seg ? sect->last_seg->cap * 2 : ASM_SEG_MIN_SIZE;
+	if (cap > ASM_SEG_MAX_SIZE) cap = ASM_SEG_MAX_SIZE;
+	if (cap < min_cap) cap = min_cap;
+	
+	asm_chunk_seg_t *seg = xalloc(ctx->allocator, sizeof(asm_chunk_seg_t) + cap);
+	seg->next   = NULL;
+	seg->cap    = cap;
+	seg->len    = 0;
+	seg->offset = 0;
+	if (sect->last_seg) {
+		sect->last_seg->next = seg;
 	} else {
-		memset(sect->chunks + sect->chunks_len, 0, len);
+		sect->first_seg = seg;
 	}
-	// Set new length.
-	sect->chunks_len += len;
+	sect->last_seg = seg;
+	return seg;
 }
 
 // Append more data to the current chunk.
 static inline void asm_append(asm_ctx_t *ctx, const char *data, size_t len) {
-	asm_append_raw(ctx, data, len);
-	// Be careful here!
-	*ctx->current_section->chunk_len += len;
+	asm_sect_t      *sect = ctx->current_section;
+	asm_chunk_seg_t *seg  = sect->last_seg;
+	if (seg->cap - seg->len < len) {
+		uint8_t *chunk = (uint8_t *) sect->chunk_len - 1;
+		if (*chunk == ASM_CHUNK_DATA && *sect->chunk_len) {
+			// Data continues in a new chunk.
+			seg = asm_add_seg(ctx, sect, ASM_CHUNK_HEADER + len);
+			seg->data[0] = ASM_CHUNK_DATA;
+			seg->len     = ASM_CHUNK_HEADER;
+			*(size_t *) (seg->data + 1) = 0;
+		} else {
+			// Other chunks move to the new segment in one piece.
+			size_t size = seg->data + seg->len - chunk;
+			seg->len -= size;
+			seg = asm_add_seg(ctx, sect, size + len);
+			memcpy(seg->data, chunk, size);
+			seg->len = size;
+		}
+		sect->chunk_len = (size_t *) (seg->data + 1);
+	}
+	// Append data.
+	if (data) {
+		memcpy(seg->data + seg->len, data, len);
+	} else {
+		memset(seg->data + seg->len, 0, len);
+	}
+	// Set new length.
+	seg->len += len;
+	*sect->chunk_len += len;
 }
 
 // Append a chunk of a certain type.
 static inline void asm_append_chunk(asm_ctx_t *ctx, char type) {
-	if (*ctx->current_section->chunk_len) {
+	asm_sect_t *sect = ctx->current_section;
+	if (*sect->chunk_len) {
 		// Add some stuff.
-		asm_append_raw(ctx, &type, 1);
-		asm_append_raw(ctx, NULL,  sizeof(size_t));
+		asm_chunk_seg_t *seg = sect->last_seg;
+		if (seg->cap - seg->len < ASM_CHUNK_HEADER) {
+			seg = asm_add_seg(ctx, sect, ASM_CHUNK_HEADER);
+		}
+		seg->data[seg->len] = type;
 		// New length pointer.
-		ctx->current_section->chunk_len = (size_t *) (ctx->current_section->chunks + ctx->current_section->chunks_len - sizeof(size_t));
+		sect->chunk_len = (size_t *) (seg->data + seg->len + 1);
+		seg->len += ASM_CHUNK_HEADER;
 	} else {
 		// Change the chunk instead of adding another.
-		char *ptr = (char *) ctx->current_section->chunk_len - 1;
+		char *ptr = (char *) sect->chunk_len - 1;
 		*ptr = type;
 	}
 	// Set the new length.
-	*ctx->current_section->chunk_len = 0;
+	*sect->chunk_len = 0;
 }
 
 
@@ -91,13 +131,14 @@ static inline void asm_append_chunk(asm_ctx_t *ctx, char type) {
 // Any alignment, even outside of powers of two accepted.
 static inline asm_sect_t *asm_create_sect(asm_ctx_t *ctx, const char *id, address_t align) {
 	asm_sect_t *sect      = (asm_sect_t *) xalloc(ctx->allocator, sizeof(asm_sect_t));
-	sect->chunks          = (uint8_t *)    xalloc(ctx->allocator, 256);
-	sect->chunks_capacity = 256;
-	sect->chunks_len      = sizeof(size_t) + 1;
-	sect->chunk_len       = (void *) sect->chunks + 1;
+	sect->first_seg       = NULL;
+	sect->last_seg        = NULL;
+	asm_chunk_seg_t *seg  = asm_add_seg(ctx, sect, 0);
+	seg->len              = ASM_CHUNK_HEADER;
+	sect->chunk_len       = (size_t *) (seg->data + 1);
 	sect->align           = align;
 	sect->size            = 0;
-	*sect->chunks         = ASM_CHUNK_DATA;
+	*seg->data            = ASM_CHUNK_DATA;
 	*sect->chunk_len      = 0;
 	map_set(ctx->sections, id, sect);
 	return sect;
@@ -223,18 +264,29 @@ char *asm_get_label(asm_ctx_t *ctx) {
 	}
 }
 
+// Finds a label by name, or returns NULL if it was never defined or referenced.
+asm_label_def_t *asm_find_label(asm_ctx_t *ctx, const char *label) {
+	return map_get(&ctx->labels, label);
+}
+
 static inline asm_label_def_t *get_or_create_label(asm_ctx_t *ctx, const char *label) {
-	asm_label_def_t *val = map_get(ctx->labels, label);
-	if (!val) {
-		val = xalloc(ctx->allocator, sizeof(asm_label_def_t));
-		*val = (asm_label_def_t) {
-			.address    = 0,
-			.is_defined = false,
-			.source     = xstrdup(ctx->allocator, label),
-			.value      = xstrdup(ctx->allocator, label)
-		};
-		map_set(ctx->labels, label, val);
-	}
+	asm_label_def_t *def = map_get(&ctx->labels, label);
+	if (def) return def;
+	
+	// The copied name doubles as the label's source and value strings.
+	size_t len  = strlen(label);
+	char  *copy = xalloc(ctx->allocator, len + 1);
+	memcpy(copy, label, len + 1);
+	asm_label_def_t *val = xalloc(ctx->allocator, sizeof(asm_label_def_t));
+	*val = (asm_label_def_t) {
+		.address    = 0,
+		.is_defined = false,
+		.source     = copy,
+		.value      = copy,
+		.id         = ctx->label_defs_len,
+	};
+	array_len_cap_concat(ctx->allocator, asm_label_def_t *, ctx->label_defs, ctx->label_defs_cap, ctx->label_defs_len, val);
+	map_set(&ctx->labels, copy, val);
 	return val;
 }
 
@@ -245,8 +297,8 @@ static void asm_write_label0(asm_ctx_t *ctx, const char *label) {
 	def->is_defined = true;
 	// New label chunk.
 	asm_append_chunk(ctx, ASM_CHUNK_LABEL);
-	// Label string.
-	asm_append(ctx, label, strlen(label) + 1);
+	// Label id.
+	asm_write_num(ctx, def->id, ASM_LABEL_ID_SIZE);
 	// New data chunk.
 	asm_append_chunk(ctx, ASM_CHUNK_DATA);
 	DEBUG_ASM("d  %s:\n", label);
@@ -277,15 +329,15 @@ void asm_write_label(asm_ctx_t *ctx, const char *label) {
 
 // Writes label references to the current chunk.
 static void asm_write_label_ref0(asm_ctx_t *ctx, const char *label, address_t offset, asm_label_ref_t mode) {
-	get_or_create_label(ctx, label);
+	asm_label_def_t *def = get_or_create_label(ctx, label);
 	// New label reference chunk.
 	asm_append_chunk(ctx, ASM_CHUNK_LABEL_REF);
 	// Label access mode.
 	asm_append(ctx, (char *) &mode, 1);
 	// Label offset.
 	asm_write_address(ctx, offset);
-	// Label string.
-	asm_append(ctx, label, strlen(label) + 1);
+	// Label id.
+	asm_write_num(ctx, def->id, ASM_LABEL_ID_SIZE);
 	// New data chunk.
 	asm_append_chunk(ctx, ASM_CHUNK_DATA);
 #ifdef DEBUG_ASSEMBLER
@@ -360,8 +412,8 @@ void asm_write_equ(asm_ctx_t *ctx, const char *label, address_t value) {
 	asm_append_chunk(ctx, ASM_CHUNK_EQU);
 	// Label value.
 	asm_write_num(ctx, value, sizeof(address_t));
-	// Label string.
-	asm_append(ctx, label, strlen(label) + 1);
+	// Label id.
+	asm_write_num(ctx, def->id, ASM_LABEL_ID_SIZE);
 	// New data chunk.
 	asm_append_chunk(ctx, ASM_CHUNK_DATA);
 	DEBUG_ASM("e  %s = 0x%x\n", label, value);
@@ -414,25 +466,67 @@ void asm_write_numb(uint8_t *buf, size_t data, size_t bytes) {
 }
 
 
-// Joins data from two asm_sect_t.
-static void asm_join_sect(asm_ctx_t *ctx, asm_ctx_t *extra, asm_sect_t *base, asm_sect_t *top) {
-	// Allocate memory for the joined array.
-	uint8_t *mem = xalloc(ctx->allocator, base->chunks_len + top->chunks_len);
-	// Concatenate contents.
-	memcpy(mem, base->chunks, base->chunks_len);
-	memcpy(mem + base->chunks_len, top->chunks, top->chunks_len);
-	
-	// Calculate sizes.
-	base->chunks_len     += top->chunks_len;
-	base->chunks_capacity = base->chunks_len;
+// Translates the label ids in chunks copied from another context.
+static void asm_remap_labels(uint8_t *chunks, size_t chunks_len, const size_t *remap) {
+	size_t index = 0;
+	while (index < chunks_len) {
+		size_t   len  = *(size_t *) (chunks + index + 1);
+		uint8_t *data = chunks + index + ASM_CHUNK_HEADER;
+		uint8_t *id   = NULL;
+		if (chunks[index] == ASM_CHUNK_LABEL) {
+			id = data;
+		} else if (chunks[index] == ASM_CHUNK_LABEL_REF) {
+			id = data + 1 + sizeof(address_t);
+		} else if (chunks[index] == ASM_CHUNK_EQU) {
+			id = data + sizeof(address_t);
+		}
+		if (id) asm_write_numb(id, remap[asm_read_numb(id, ASM_LABEL_ID_SIZE)], ASM_LABEL_ID_SIZE);
+		index += len + ASM_CHUNK_HEADER;
+	}
+}
+
+// Joins data from two asm_sect_t, moving the chunks of `top` to the end of `base`.
+static void asm_join_sect(asm_sect_t *base, asm_sect_t *top, const size_t *remap) {
+	if (remap) {
+		for (asm_chunk_seg_t *seg = top->first_seg; seg; seg = seg->next) {
+			asm_remap_labels(seg->data, seg->len, remap);
+		}
+	}
 	
-	// Update pointers.
-	base->chunks          = mem;
-	base->chunk_len       = top->chunk_len - (size_t) top->chunks + (size_t) base->chunks;
+	// Splice the segments in without copying.
+	base->last_seg->next = top->first_seg;
+	base->last_seg       = top->last_seg;
+	base->chunk_len      = top->chunk_len;
+	top->first_seg       = NULL;
+	top->last_seg        = NULL;
+	top->chunk_len       = NULL;
 }
 
 // Joins two asm_ctx_t, appending from `extra` onto `ctx`.
-void asm_join(asm_ctx_t *ctx, asm_ctx_t *extra) {
+// Chunk data is moved rather than copied, so `extra` is used up and its memory now belongs to `ctx`.
+// Returns false if a label is defined in both.
+bool asm_join(asm_ctx_t *ctx, asm_ctx_t *extra) {
+	// Label ids differ between contexts, so map those of `extra` onto `ctx`.
+	size_t *remap    = xalloc(ctx->allocator, sizeof(size_t) * extra->label_defs_len);
+	bool    identity = true;
+	bool    success  = true;
+	for (size_t i = 0; i < extra->label_defs_len; i++) {
+		asm_label_def_t *top = extra->label_defs[i];
+		asm_label_def_t *def = get_or_create_label(ctx, top->source);
+		if (top->is_defined) {
+			if (def->is_defined) {
+				printf("Error: Label '%s' is defined more than once\n", top->source);
+				success = false;
+			}
+			// Addresses are only assigned in post-processing, so there is nothing else to copy.
+			def->is_defined = true;
+		}
+		remap[i]  = def->id;
+		identity &= def->id == i;
+	}
+	// Unlike the names, the index of `extra` is not on its allocator.
+	map_delete(&extra->labels);
+	
 	for (size_t i = 0; i < extra->sections->numEntries; i++) {
 		// Locate sections.
 		asm_sect_t *top  = (asm_sect_t *) extra->sections->values[i];
@@ -445,6 +539,11 @@ void asm_join(asm_ctx_t *ctx, asm_ctx_t *extra) {
 		}
 		
 		// Do a per-section merger.
-		asm_join_sect(ctx, extra, base, top);
+		asm_join_sect(base, top, identity ? NULL : remap);
 	}
+	xfree(ctx->allocator, remap);
+	
+	// The chunks now in `ctx` live as long as it does.
+	alloc_handoff_to(ctx->allocator, extra->allocator);
+	return success;
 }
@@ -15,6 +15,16 @@
 
 #define ASM_NOT_ALIGNED     0
 
+// Size of the label ids stored in label, label reference and equation chunks.
+#define ASM_LABEL_ID_SIZE   sizeof(uint32_t)
+// Size of the type and length that precede the data of every chunk.
+#define ASM_CHUNK_HEADER    (1 + sizeof(size_t))
+
+// Size of the first chunk segment of a section.
+#define ASM_SEG_MIN_SIZE    256
+// Maximum size of later chunk segments, unless a single append is larger.
+#define ASM_SEG_MAX_SIZE    65536
+
 struct asm_scope;
 struct asm_ctx;
 struct asm_sect;
@@ -28,6 +38,10 @@ typedef struct asm_ctx asm_ctx_t;
 typedef struct asm_sect asm_sect_t;
 // One label and information about it.
 typedef struct asm_label_def asm_label_def_t;
+// One definition of a variable, possibly shadowing another.
+typedef struct asm_symbol asm_symbol_t;
+// A block of chunks belonging to a section.
+typedef struct asm_chunk_seg asm_chunk_seg_t;
 
 typedef char *asm_label_t;
 
@@ -37,8 +51,8 @@ typedef char *asm_label_t;
 struct asm_scope {
     // The parent scope.
     asm_scope_t *parent;
-    // A map of the variables in the given scope.
-    map_t        vars;
+    // Length of the symbol undo log when this scope was entered.
+    size_t       undo_base;
     // The total number of variables in the entire hierarchy.
     size_t       num;
     // The total number of variables excluding global variables.
@@ -67,8 +81,19 @@ struct asm_ctx {
     tokeniser_ctx_t *tokeniser_ctx;
     // All the functions defined in the global scope.
     map_t         functions;
-    // All the labels that are defined or referenced.
-    map_t        *labels;
+    // All the labels that are defined or referenced, by id, in order of first use.
+    asm_label_def_t **label_defs;
+    size_t        label_defs_len;
+    size_t        label_defs_cap;
+    // The same labels by name, compared by content.
+    // Label names are copied into this context, so they are freed along with it.
+    map_t         labels;
+    // The innermost visible definition of every variable, by interned name.
+    map_t         symbols;
+    // Names of the variables defined, in order, so they can be undone when their scope is closed.
+    const char  **symbol_undo;
+    size_t        symbol_undo_len;
+    size_t        symbol_undo_cap;
     // The global scope.
     asm_scope_t   global_scope;
     // The current scope.
@@ -100,22 +125,23 @@ struct asm_ctx {
     /* ===== Post-processing ===== */
     // The current PC.
     address_t   pc;
+    // Whether post-processing pass 1 ran past the end of the address space.
+    bool        pc_overflow;
     // The output file descriptor to be used.
     FILE       *out_fd;
     // The outputfile descriptor for addr2line files.
     FILE       *out_addr2line;
+    // The output file descriptor for a hex dump of the output, if any.
+    FILE       *out_hexdump;
 };
 
 struct asm_sect {
     /* ========== Data =========== */
-    // Data stored in this section.
-    uint8_t    *chunks;
-    // Length of the current chunk of data.
+    // Data stored in this section, as a list of segments that never move.
+    asm_chunk_seg_t *first_seg;
+    asm_chunk_seg_t *last_seg;
+    // Length of the current chunk of data, which is in the last segment.
     size_t     *chunk_len;
-    // Capacity for data.
-    size_t      chunks_capacity;
-    // Used data.
-    size_t      chunks_len;
     // Alignment of this section.
     address_t   align;
     // Size of section contents in memory.
@@ -126,11 +152,35 @@ struct asm_sect {
     address_t   offset;
 };
 
+struct asm_chunk_seg {
+    // The next segment of the section.
+    asm_chunk_seg_t *next;
+    // Capacity for data.
+    size_t      cap;
+    // Used data.
+    size_t      len;
+    // Address of the first chunk, known after post-processing pass 1.
+    address_t   offset;
+    // Chunks, which are never split between segments.
+    uint8_t     data[];
+};
+
+struct asm_symbol {
+    // The variable.
+    gen_var_t    *var;
+    // The scope it is defined in.
+    asm_scope_t  *scope;
+    // The definition of the same name it shadows, if any.
+    asm_symbol_t *shadowed;
+};
+
 struct asm_label_def {
     // Label value as is from source code.
     asm_label_t source;
     // Label value as in text
     char       *value;
+    // Index in asm_ctx::label_defs, which chunks refer to the label by.
+    size_t      id;
     // Whether the label is defined in this compilation.
     bool        is_defined;
     // At post-processing time: the label's address.
@@ -161,6 +211,8 @@ void asm_write_num      (asm_ctx_t *ctx, size_t      data, size_t     bytes);
 
 // Gets a new label based on asm_ctx::last_label_no.
 char *asm_get_label     (asm_ctx_t *ctx);
+// Finds a label by name, or returns NULL if it was never defined or referenced.
+asm_label_def_t *asm_find_label(asm_ctx_t *ctx, const char *label);
 // Writes label definitions to the current chunk.
 void asm_write_label    (asm_ctx_t *ctx, const char *label);
 // Writes label references to the current chunk.
@@ -181,6 +233,9 @@ size_t asm_read_numb    (uint8_t   *buf, size_t      bytes);
 void asm_write_numb     (uint8_t   *buf, size_t      data,  size_t    bytes);
 
 // Joins two asm_ctx_t, appending from `extra` onto `ctx`.
-void asm_join           (asm_ctx_t *ctx, asm_ctx_t *extra);
+// Chunk data is moved rather than copied, so `extra` is used up and its memory now belongs to `ctx`.
+// `extra` must not be used or destroyed afterwards; its allocator is freed along with `ctx->allocator`.
+// Returns false if a label is defined in both.
+bool asm_join           (asm_ctx_t *ctx, asm_ctx_t *extra);
 
 #endif //ASM_H
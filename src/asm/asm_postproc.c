@@ -7,6 +7,43 @@
 #include <fcntl.h>
 #include <string.h>
 #include <stdlib.h>
+#include <pthread.h>
+
+// Maximum number of threads used by asm_ppc_iterate_parallel.
+#define ASM_PPC_MAX_THREADS  16
+// Amount of chunk data below which asm_ppc_iterate_parallel doesn't bother with threads.
+#define ASM_PPC_PARALLEL_MIN 65536
+
+size_t asm_ppc_threads = 0;
+
+// Work shared by the threads of asm_ppc_iterate_parallel.
+typedef struct {
+	asm_ctx_t        *ctx;
+	// Segments to process, with the sections they belong to.
+	asm_sect_t      **sects;
+	asm_chunk_seg_t **segs;
+	size_t            n_segs;
+	// Index of the next segment to process.
+	size_t            next;
+	asm_ppc_pass_t    func;
+	void             *func_args;
+} asm_ppc_work_t;
+
+// Calls a function for each chunk in a segment.
+static inline void asm_ppc_iterate_seg(asm_ctx_t *ctx, asm_sect_t *sect, asm_chunk_seg_t *seg, asm_ppc_pass_t func, void *func_args) {
+	size_t index = 0;
+	while (index < seg->len) {
+		size_t len = *(size_t *) (seg->data + index + 1);
+		(*func)(ctx, sect, seg->data[index], len, seg->data + index + ASM_CHUNK_HEADER, func_args);
+		index += len + ASM_CHUNK_HEADER;
+	}
+}
+
+// Whether n words starting at pc end within the address space.
+// The end of the program must be an address itself, so that section sizes fit in address_t.
+static inline bool asm_ppc_fits(address_t pc, size_t n) {
+	return (size_t) pc + n <= (address_t) -1;
+}
 
 void asm_ppc_iterate(asm_ctx_t *ctx, size_t n_sect, char **sect_ids, asm_sect_t **sects, asm_ppc_pass_t func, void *func_args, bool use_align) {
 	// Iterate over the sections.
@@ -22,6 +59,7 @@ void asm_ppc_iterate(asm_ctx_t *ctx, size_t n_sect, char **sect_ids, asm_sect_t
 			if (sects[i]->align > 1) {
 				address_t error = offs % sects[i]->align;
 				if (error) {
+					if (!asm_ppc_fits(offs, sects[i]->align - error)) ctx->pc_overflow = true;
 					offs += sects[i]->align - error;
 				}
 				ctx->pc = offs;
@@ -40,13 +78,92 @@ void asm_ppc_iterate(asm_ctx_t *ctx, size_t n_sect, char **sect_ids, asm_sect_t
 		}
 		
 		// Iterate over the chunks.
-		size_t index = 0;
-		while (index < sect->chunks_len) {
-			size_t len = *(size_t *) (sect->chunks + index + 1);
-			(*func)(ctx, sect, sect->chunks[index], len, sect->chunks + index + sizeof(size_t) + 1, func_args);
-			index += len + sizeof(size_t) + 1;
+		for (asm_chunk_seg_t *seg = sect->first_seg; seg; seg = seg->next) {
+			// Remember where the segment starts so it can be processed on its own later.
+			seg->offset = ctx->pc;
+			asm_ppc_iterate_seg(ctx, sect, seg, func, func_args);
+		}
+	}
+}
+
+// Processes segments until there are none left.
+static void *asm_ppc_worker(void *arg) {
+	asm_ppc_work_t *work = arg;
+	// Each thread has its own program counter.
+	asm_ctx_t ctx = *work->ctx;
+	size_t i;
+	while ((i = __atomic_fetch_add(&work->next, 1, __ATOMIC_RELAXED)) < work->n_segs) {
+		ctx.pc = work->segs[i]->offset;
+		asm_ppc_iterate_seg(&ctx, work->sects[i], work->segs[i], work->func, work->func_args);
+	}
+	return NULL;
+}
+
+// Like asm_ppc_iterate with use_align, but spreads the chunks over multiple threads.
+// Only valid after pass 1; func must be thread-safe and may only rely on the pc of the ctx it is given.
+void asm_ppc_iterate_parallel(asm_ctx_t *ctx, size_t n_sect, char **sect_ids, asm_sect_t **sects, asm_ppc_pass_t func, void *func_args) {
+	// Count the work.
+	size_t n_segs = 0;
+	size_t total  = 0;
+	for (size_t i = 0; i < n_sect; i++) {
+		for (asm_chunk_seg_t *seg = sects[i]->first_seg; seg; seg = seg->next) {
+			n_segs ++;
+			total += seg->len;
+		}
+	}
+	long   n_cpus    = sysconf(_SC_NPROCESSORS_ONLN);
+	size_t n_threads = asm_ppc_threads ? asm_ppc_threads : n_cpus > 0 ? n_cpus : 1;
+	if (n_threads > ASM_PPC_MAX_THREADS) n_threads = ASM_PPC_MAX_THREADS;
+	if (n_threads > n_segs) n_threads = n_segs;
+	if (n_threads < 2 || (!asm_ppc_threads && total < ASM_PPC_PARALLEL_MIN)) {
+		// Not worth the threads.
+		asm_ppc_iterate(ctx, n_sect, sect_ids, sects, func, func_args, true);
+		return;
+	}
+	
+	// List the segments.
+	asm_ppc_work_t work = {
+		.ctx       = ctx,
+		.sects     = xalloc(ctx->allocator, sizeof(asm_sect_t *) * n_segs),
+		.segs      = xalloc(ctx->allocator, sizeof(asm_chunk_seg_t *) * n_segs),
+		.n_segs    = n_segs,
+		.next      = 0,
+		.func      = func,
+		.func_args = func_args,
+	};
+	size_t n = 0;
+	for (size_t i = 0; i < n_sect; i++) {
+		DEBUG_ASM("Loading offset for %s as %04x\n", sect_ids[i], sects[i]->offset);
+		for (asm_chunk_seg_t *seg = sects[i]->first_seg; seg; seg = seg->next) {
+			work.sects[n] = sects[i];
+			work.segs[n]  = seg;
+			n ++;
 		}
 	}
+	
+	// This thread helps out too.
+	pthread_t threads[ASM_PPC_MAX_THREADS];
+	size_t    started = 0;
+	for (; started < n_threads - 1; started++) {
+		if (pthread_create(&threads[started], NULL, asm_ppc_worker, &work)) break;
+	}
+	asm_ppc_worker(&work);
+	for (size_t i = 0; i < started; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	
+	// Leave the pc where asm_ppc_iterate would.
+	ctx->pc = sects[n_sect - 1]->offset + sects[n_sect - 1]->size;
+	xfree(ctx->allocator, work.sects);
+	xfree(ctx->allocator, work.segs);
+}
+
+// Advances the PC for pass 1, noting whether it runs out of address space.
+static inline void asm_ppc_advance(asm_ctx_t *ctx, asm_sect_t *sect, size_t n) {
+	if (!asm_ppc_fits(ctx->pc, n)) ctx->pc_overflow = true;
+	ctx->pc += n;
+	// Count towards size.
+	sect->size += n;
 }
 
 // Pass 1: label resolution.
@@ -55,35 +172,27 @@ void asm_ppc_pass1(asm_ctx_t *ctx, asm_sect_t *sect, uint8_t chunk_type, size_t
 	if (chunk_type == ASM_CHUNK_ZERO) {
 		// A chunk that indicates zeroes (usualy for .bss).
 		size_t n = asm_read_numb(chunk_data, sizeof(address_t));
-		ctx->pc += n;
-		// Count towards size.
-		sect->size += chunk_len / sizeof(memword_t);
+		asm_ppc_advance(ctx, sect, n);
 	} else if (chunk_type == ASM_CHUNK_DATA) {
 		// A chunk with raw output data.
-		ctx->pc += chunk_len / sizeof(memword_t);
-		// Count towards size.
-		sect->size += chunk_len / sizeof(memword_t);
+		asm_ppc_advance(ctx, sect, chunk_len / sizeof(memword_t));
 	} else if (chunk_type == ASM_CHUNK_LABEL_REF) {
 		// A label reference.
-		ctx->pc += ADDRESS_TO_MEMWORDS;
-		// Count towards size.
-		sect->size += ADDRESS_TO_MEMWORDS;
+		asm_ppc_advance(ctx, sect, ADDRESS_TO_MEMWORDS);
 	} else if (chunk_type == ASM_CHUNK_LABEL) {
 		// Look up the label.
-		char *label = chunk_data;
-		asm_label_def_t *def = map_get(ctx->labels, label);
+		asm_label_def_t *def = ctx->label_defs[asm_read_numb(chunk_data, ASM_LABEL_ID_SIZE)];
 		// And assign the current PC to it.
 		def->address = ctx->pc;
-		printf("%-20s @ %04x\n", label, def->address);
+		printf("%-20s @ %04x\n", def->source, def->address);
 	} else if (chunk_type == ASM_CHUNK_EQU) {
 		// Get address.
 		address_t addr = asm_read_numb(chunk_data, sizeof(address_t));
 		// Look up the label.
-		char *label = chunk_data + sizeof(address_t);
-		asm_label_def_t *def = map_get(ctx->labels, label);
+		asm_label_def_t *def = ctx->label_defs[asm_read_numb(chunk_data + sizeof(address_t), ASM_LABEL_ID_SIZE)];
 		// And assign the equation result to it.
 		def->address = addr;
-		printf("%-20s = %04x\n", label, def->address);
+		printf("%-20s = %04x\n", def->source, def->address);
 	} else if (chunk_type == ASM_CHUNK_POS) {
 		// A position chuck (usually for addr2line purposes).
 		(*(address_t *) chunk_data) = ctx->pc;
@@ -93,13 +202,13 @@ void asm_ppc_pass1(asm_ctx_t *ctx, asm_sect_t *sect, uint8_t chunk_type, size_t
 // Post-processes the label reference for outputting.
 bool asm_ppc_label(asm_ctx_t *ctx, uint8_t *chunk, uint8_t *buf, size_t *len) {
 	// Extrach chunk data.
-	char *label = chunk + sizeof(address_t) + 1;
 	asm_label_ref_t mode = *chunk;
 	address_t offs = asm_read_numb(chunk + 1, sizeof(address_t));
+	size_t id = asm_read_numb(chunk + 1 + sizeof(address_t), ASM_LABEL_ID_SIZE);
 	
 	// Check whether we know it's value.
-	asm_label_def_t *def = map_get(ctx->labels, label);
-	if (!def) return false;
+	if (id >= ctx->label_defs_len) return false;
+	asm_label_def_t *def = ctx->label_defs[id];
 	address_t value = def->address + offs;
 	
 	switch (mode) {
@@ -190,10 +299,9 @@ void asm_ppc_addr2line(asm_ctx_t *ctx, asm_sect_t *sect, uint8_t chunk_type, siz
 		
 	} else if (chunk_type == ASM_CHUNK_LABEL) {
 		// Look up the label.
-		char *label = chunk_data;
-		asm_label_def_t *def = map_get(ctx->labels, label);
+		asm_label_def_t *def = ctx->label_defs[asm_read_numb(chunk_data, ASM_LABEL_ID_SIZE)];
 		if (def->is_defined) {
-			char *nameesc = escapespaces(label);
+			char *nameesc = escapespaces(def->source);
 			
 			// Format: "label", label name, address
 			fprintf(ctx->out_addr2line, "label %s %x\n",
@@ -223,3 +331,36 @@ void asm_sects_addr2line(asm_ctx_t *ctx) {
 		free(nameesc);
 	}
 }
+
+// Two hexadecimal digits for every byte value.
+#define ASM_HEX_ROW(x) x"0"x"1"x"2"x"3"x"4"x"5"x"6"x"7"x"8"x"9"x"A"x"B"x"C"x"D"x"E"x"F"
+static const char asm_hex_pairs[] =
+	ASM_HEX_ROW("0") ASM_HEX_ROW("1") ASM_HEX_ROW("2") ASM_HEX_ROW("3")
+	ASM_HEX_ROW("4") ASM_HEX_ROW("5") ASM_HEX_ROW("6") ASM_HEX_ROW("7")
+	ASM_HEX_ROW("8") ASM_HEX_ROW("9") ASM_HEX_ROW("A") ASM_HEX_ROW("B")
+	ASM_HEX_ROW("C") ASM_HEX_ROW("D") ASM_HEX_ROW("E") ASM_HEX_ROW("F");
+
+// Dumps an output image in hexadecimal, formatted like `hexdump -ve '8/2 "%04X " "\n"'`.
+void asm_ppc_hexdump(FILE *fd, const uint8_t *image, size_t len) {
+	// Eight 16-bit words per line, each followed by a space.
+	char line[8 * 5 + 1];
+	for (size_t pos = 0; pos < len; pos += 16) {
+		char *out = line;
+		for (size_t i = pos; i < pos + 16; i += 2) {
+			if (i < len) {
+				// A lone last byte is padded with zero, like hexdump does.
+				uint16_t word = 0;
+				memcpy(&word, image + i, len - i > 1 ? 2 : 1);
+				memcpy(out,     asm_hex_pairs + (word >> 8)   * 2, 2);
+				memcpy(out + 2, asm_hex_pairs + (word & 0xff) * 2, 2);
+			} else {
+				// Past the end, hexdump prints blanks.
+				memset(out, ' ', 4);
+			}
+			out[4] = ' ';
+			out   += 5;
+		}
+		*out++ = '\n';
+		fwrite(line, 1, out - line, fd);
+	}
+}
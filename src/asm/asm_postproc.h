@@ -6,8 +6,15 @@
 
 typedef void(*asm_ppc_pass_t)(asm_ctx_t *ctx, asm_sect_t *sect, uint8_t chunk_type, size_t chunk_len, uint8_t *chunk_data, void *args);
 
+// Number of threads asm_ppc_iterate_parallel uses regardless of CPUs and program size, 0 to decide by itself.
+// Meant for testing the threaded path on small programs and single-CPU hosts.
+extern size_t asm_ppc_threads;
+
 // Iterates over sections and chunks in ctx and calls a function for each chunk.
 void asm_ppc_iterate(asm_ctx_t *ctx, size_t n_sect, char **sect_ids, asm_sect_t **sects, asm_ppc_pass_t func, void *func_args, bool use_align);
+// Like asm_ppc_iterate with use_align, but spreads the chunks over multiple threads.
+// Only valid after pass 1; func must be thread-safe and may only rely on the pc of the ctx it is given.
+void asm_ppc_iterate_parallel(asm_ctx_t *ctx, size_t n_sect, char **sect_ids, asm_sect_t **sects, asm_ppc_pass_t func, void *func_args);
 
 // Pass 1: label resolution.
 void asm_ppc_pass1(asm_ctx_t *ctx, asm_sect_t *sect, uint8_t chunk_type, size_t chunk_len, uint8_t *chunk_data, void *args);
@@ -29,7 +36,11 @@ void asm_ppc_addr2line(asm_ctx_t *ctx, asm_sect_t *sect, uint8_t chunk_type, siz
 // Adds sections to the dump file.
 void asm_sects_addr2line(asm_ctx_t *ctx);
 
+// Dumps an output image in hexadecimal, formatted like `hexdump -ve '8/2 "%04X " "\n"'`.
+void asm_ppc_hexdump(FILE *fd, const uint8_t *image, size_t len);
+
 // Outputs in the target architecture's native format.
-void output_native(asm_ctx_t *ctx);
+// Returns true on success.
+bool output_native(asm_ctx_t *ctx);
 
 #endif //ASM_POSTPROC_H
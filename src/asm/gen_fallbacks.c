@@ -813,7 +813,7 @@ gen_var_t *gen_expression(asm_ctx_t *ctx, expr_t *expr, gen_var_t *out_hint) {
 			gen_var_t *val = gen_get_variable(ctx, expr->ident->strval);
 			if (!val) {
 				// Is it maybe a function?
-				funcdef_t *func = map_get(&ctx->functions, expr->ident->strval);
+				funcdef_t *func = map_get_interned(&ctx->functions, expr->ident->strval);
 				if (func) {
 					// It's a function, so make a label variable out of it.
 					val = (gen_var_t *) xalloc(ctx->allocator, sizeof(gen_var_t));
@@ -844,7 +844,7 @@ gen_var_t *gen_expression(asm_ctx_t *ctx, expr_t *expr, gen_var_t *out_hint) {
 			if (expr->func->type == EXPR_TYPE_IDENT) {
 				// Funcdef lookup.
 				const char *name = expr->func->ident->strval;
-				funcdef = map_get(&ctx->functions, name);
+				funcdef = map_get_interned(&ctx->functions, name);
 				
 				if (!funcdef) {
 					// Undefined function called.
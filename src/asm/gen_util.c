@@ -1,6 +1,7 @@
 
 #include "gen_util.h"
 #include "strmap.h"
+#include "array_util.h"
 #include "string.h"
 #include "malloc.h"
 
@@ -176,14 +177,10 @@ bool ctype_equals(asm_ctx_t *ctx, var_type_t *a, var_type_t *b) {
 
 
 // Find and return the location of the variable with the given name.
+// The name must be interned, like all identifiers from the tokeniser.
 gen_var_t *gen_get_variable(asm_ctx_t *ctx, char *label) {
-	asm_scope_t *scope = ctx->current_scope;
-	while (scope) {
-		gen_var_t *var = (gen_var_t *) map_get(&scope->vars, label);
-		if (var) return var;
-		scope = scope->parent;
-	}
-	return NULL;
+	asm_symbol_t *sym = map_get_interned(&ctx->symbols, label);
+	return sym ? sym->var : NULL;
 }
 
 // Decay some sort of array type into a pointer type.
@@ -194,7 +191,7 @@ gen_var_t *gen_arr_decay(asm_ctx_t *ctx, gen_var_t *var, gen_var_t *out_hint) {
 		gen_mov(ctx, var->default_loc, var);
 		void *to_free = var->default_loc;
 		*var = *var->default_loc;
-		xfree(to_free, ctx->current_scope->allocator);
+		xfree(ctx->current_scope->allocator, to_free);
 	}
 	
 	// Produce a pointer by performing OP_DEREF.
@@ -202,9 +199,25 @@ gen_var_t *gen_arr_decay(asm_ctx_t *ctx, gen_var_t *var, gen_var_t *out_hint) {
 }
 
 // Define the variable with the given ident.
+// The ident must be interned, like all identifiers from the tokeniser.
 bool gen_define_var(asm_ctx_t *ctx, gen_var_t *var, char *ident) {
-	void *repl = map_set(&ctx->current_scope->vars, ident, var);
-	if (repl) return false;
+	const char   *name = ident;
+	asm_symbol_t *top  = map_get_interned(&ctx->symbols, name);
+	if (top && top->scope == ctx->current_scope) {
+		// Already defined in this scope.
+		top->var = var;
+		return false;
+	}
+	
+	// Shadow any definition from outer scopes.
+	asm_symbol_t *sym = xalloc(ctx->current_scope->allocator, sizeof(asm_symbol_t));
+	*sym = (asm_symbol_t) {
+		.var      = var,
+		.scope    = ctx->current_scope,
+		.shadowed = top,
+	};
+	map_set_interned(&ctx->symbols, name, sym);
+	array_len_cap_concat(ctx->allocator, const char *, ctx->symbol_undo, ctx->symbol_undo_cap, ctx->symbol_undo_len, name);
 	
 	if (ctx->current_scope != &ctx->global_scope) {
 		// Don't want to deal with global variable numbers inside functions.
@@ -372,9 +385,9 @@ char *esc_cstr(alloc_ctx_t allocator, const char *cstr, size_t len) {
 void gen_push_scope(asm_ctx_t *ctx) {
 	asm_scope_t *scope = (asm_scope_t *) xalloc(ctx->allocator, sizeof(asm_scope_t));
 	*scope = *ctx->current_scope;
-	scope->allocator   = alloc_create(ctx->allocator);
+	scope->allocator   = alloc_create_arena(ctx->allocator);
 	scope->parent      = ctx->current_scope;
-	map_create(&scope->vars);
+	scope->undo_base   = ctx->symbol_undo_len;
 	ctx->current_scope = scope;
 }
 
@@ -383,8 +396,12 @@ void gen_pop_scope(asm_ctx_t *ctx) {
 	asm_scope_t *old = ctx->current_scope;
 	address_t real_size = ctx->current_scope->real_stack_size;
 	
-	// Delete the map.
-	map_delete(&old->vars);
+	// Restore the definitions this scope shadowed.
+	while (ctx->symbol_undo_len > old->undo_base) {
+		const char   *name = ctx->symbol_undo[-- ctx->symbol_undo_len];
+		asm_symbol_t *sym  = map_get_interned(&ctx->symbols, name);
+		map_set_interned(&ctx->symbols, name, sym->shadowed);
+	}
 	alloc_destroy(old->allocator);
 	
 	// Unlink it.
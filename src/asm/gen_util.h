@@ -29,11 +29,13 @@ var_type_t *ctype_ptr        (asm_ctx_t *ctx, var_type_t   *of);
 bool        ctype_equals     (asm_ctx_t *ctx, var_type_t *a, var_type_t *b);
 
 // Find and return the location of the variable with the given name.
+// The name must be interned.
 gen_var_t *gen_get_variable  (asm_ctx_t *ctx, char      *label);
 // Decay some sort of array type into a pointer type.
 // Generates code to do so.
 gen_var_t *gen_arr_decay     (asm_ctx_t *ctx, gen_var_t *var, gen_var_t *out_hint);
 // Define the variable with the given ident.
+// The ident must be interned.
 bool       gen_define_var    (asm_ctx_t *ctx, gen_var_t *var, char *ident);
 // Define a temp var label.
 bool       gen_define_temp   (asm_ctx_t *ctx, char      *label);
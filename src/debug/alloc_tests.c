@@ -1,6 +1,48 @@
 
 #include <main.h>
 #include <ctxalloc.h>
+#include <pthread.h>
+
+#ifdef ALLOC_TEST
+// Number of threads and strings per thread for the handoff test.
+#define HANDOFF_THREADS 8
+#define HANDOFF_STRINGS 1000
+
+// One thread of the handoff test.
+typedef struct {
+	alloc_ctx_t parent;
+	int         id;
+	char       *strings[HANDOFF_STRINGS];
+} handoff_test_t;
+
+// Fills an arena under the shared parent, hands it off and exits.
+static void *handoff_thread(void *arg) {
+	handoff_test_t *test = arg;
+	alloc_ctx_t arena = alloc_create_arena(test->parent);
+	// Fill it once and clear it so the blocks land in this thread's cache.
+	for (int i = 0; i < HANDOFF_STRINGS; i++) {
+		alloc_on_ctx(arena, 64 + i % 300);
+	}
+	alloc_clear(arena);
+	// Fill it again from the cache, with some growing and freeing in between.
+	for (int i = 0; i < HANDOFF_STRINGS; i++) {
+		char *buf = alloc_on_ctx(arena, 32);
+		sprintf(buf, "thread %d string %d", test->id, i);
+		if (i % 7 == 0) buf = realloc_on_ctx(arena, buf, 600);
+		if (i % 5 == 0) free_on_ctx(arena, alloc_on_ctx(arena, 100));
+		test->strings[i] = buf;
+	}
+	// Memory of the shared global context, resized and freed through this thread's own context.
+	for (int i = 0; i < 100; i++) {
+		void *mem = alloc_on_ctx(global_alloc, 40);
+		mem = realloc_on_ctx(arena, mem, 4000);
+		free_on_ctx(arena, mem);
+	}
+	alloc_handoff(arena);
+	alloc_thread_cleanup();
+	return NULL;
+}
+#endif
 
 void perform_alloc_tests(int argc, char **argv) {
 	
@@ -33,6 +75,57 @@ void perform_alloc_tests(int argc, char **argv) {
 	alloc_on_ctx(ctx1, 2);
 	alloc_on_ctx(ctx1, 2);
 	alloc_destroy(ctx1);
+	
+	// Arena allocation, small and large.
+	alloc_ctx_t arena = alloc_create_arena(ALLOC_NO_PARENT);
+	for (int i = 0; i < 1000; i ++) {
+		char *buf = alloc_on_ctx(arena, i + 10);
+		sprintf(buf, "test %x\n", i);
+	}
+	alloc_clear(arena);
+	
+	// Growing arena memory, into a large allocation.
+	char *a1 = alloc_on_ctx(arena, 5);
+	strcpy(a1, "test");
+	for (size_t i = 6; i < 5000; i += 7) {
+		a1 = realloc_on_ctx(arena, a1, i);
+	}
+	if (strcmp(a1, "test")) fprintf(stderr, "Arena realloc lost data!\n");
+	free_on_ctx(arena, a1);
+	free_on_ctx(arena, alloc_on_ctx(arena, 3));
+	
+	// Growing the most recent arena allocation doesn't move it.
+	char *a2 = alloc_on_ctx(arena, 300);
+	if (realloc_on_ctx(arena, a2, 600) != a2) fprintf(stderr, "Arena tail realloc moved!\n");
+	alloc_destroy(arena);
+	
+	// Arenas filled on other threads and handed off to a shared parent.
+	alloc_ctx_t     parent = alloc_create(ALLOC_NO_PARENT);
+	handoff_test_t  tests[HANDOFF_THREADS];
+	pthread_t       threads[HANDOFF_THREADS];
+	for (int i = 0; i < HANDOFF_THREADS; i++) {
+		tests[i].parent = parent;
+		tests[i].id     = i;
+		pthread_create(&threads[i], NULL, handoff_thread, &tests[i]);
+	}
+	for (int i = 0; i < HANDOFF_THREADS; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	// The memory outlives the threads until the parent is cleared.
+	char expected[64];
+	for (int i = 0; i < HANDOFF_THREADS; i++) {
+		for (int x = 0; x < HANDOFF_STRINGS; x++) {
+			sprintf(expected, "thread %d string %d", i, x);
+			if (strcmp(tests[i].strings[x], expected)) {
+				fprintf(stderr, "Handed off memory lost data!\n");
+				i = HANDOFF_THREADS;
+				break;
+			}
+		}
+	}
+	alloc_clear(parent);
+	alloc_destroy(parent);
+	alloc_thread_cleanup();
 #endif
 	
 	// Crashing alloc tests.
@@ -58,4 +151,14 @@ void perform_alloc_tests(int argc, char **argv) {
 	fprintf(stderr, "Alloc crash test 3 failed!\n");
 #endif
 	
+#ifdef ALLOC_CRASH4
+	// Write to freed memory (checked builds only).
+	alloc_ctx_t ctx5 = alloc_create_arena(ALLOC_NO_PARENT);
+	char *ctx5mem = alloc_on_ctx(ctx5, 40);
+	free_on_ctx(ctx5, ctx5mem);
+	ctx5mem[20] = 1;
+	alloc_on_ctx(ctx5, 40);
+	fprintf(stderr, "Alloc crash test 4 failed!\n");
+#endif
+	
 }
@@ -0,0 +1,237 @@
+
+#include "bench.h"
+#include "corpus.h"
+#include "compile.h"
+#include "tokeniser.h"
+#include "parser.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+
+// Number of identifiers in the keyword benchmark corpus.
+#define KEYW_BENCH_CORPUS 1000000
+// Number of passes over the keyword benchmark corpus.
+#define KEYW_BENCH_PASSES 20
+// Default size in bytes of the frontend benchmark corpus.
+#define FRONTEND_BENCH_SIZE (1024*1024)
+// Seed for generated corpora.
+#define CORPUS_SEED 0x1234567
+
+typedef struct {
+	int keyw;
+	char *str;
+} keyw_map_t;
+
+// The linear keyword table the tokeniser used to scan, kept as a reference.
+static const keyw_map_t keyw_map[] = {
+	(keyw_map_t) { .keyw=TKN_VOID,     .str="void" },
+	(keyw_map_t) { .keyw=TKN_SHORT,    .str="short" },
+	(keyw_map_t) { .keyw=TKN_INT,      .str="int" },
+	(keyw_map_t) { .keyw=TKN_LONG,     .str="long" },
+	(keyw_map_t) { .keyw=TKN_CHAR,     .str="char" },
+	(keyw_map_t) { .keyw=TKN_FLOAT,    .str="float" },
+	(keyw_map_t) { .keyw=TKN_DOUBLE,   .str="double" },
+	(keyw_map_t) { .keyw=TKN_BOOL,     .str="bool" },
+	(keyw_map_t) { .keyw=TKN_SIGNED,   .str="signed" },
+	(keyw_map_t) { .keyw=TKN_UNSIGNED, .str="unsigned" },
+	(keyw_map_t) { .keyw=TKN_IF,       .str="if" },
+	(keyw_map_t) { .keyw=TKN_ELSE,     .str="else" },
+	(keyw_map_t) { .keyw=TKN_WHILE,    .str="while" },
+	(keyw_map_t) { .keyw=TKN_FOR,      .str="for" },
+	(keyw_map_t) { .keyw=TKN_RETURN,   .str="return" },
+	(keyw_map_t) { .keyw=TKN_ASM,      .str="asm" },
+	(keyw_map_t) { .keyw=TKN_GOTO,     .str="goto" },
+	(keyw_map_t) { .keyw=TKN_VOLATILE, .str="volatile" },
+	(keyw_map_t) { .keyw=TKN_INLINE,   .str="inline" },
+};
+static const size_t keyw_map_len = sizeof(keyw_map) / sizeof(keyw_map_t);
+
+// Identifiers that share a length or prefix with keywords, to defeat early outs.
+static const char *keyw_lookalikes[] = {
+	"i", "in", "ix", "it", "index", "iter", "integer", "info", "init",
+	"f", "fn", "foo", "form", "flags", "format", "forward",
+	"a", "arg", "args", "asmx", "addr", "array", "value", "var", "vec",
+	"len", "last", "line", "lower", "count", "ctx", "c", "ch", "cur",
+	"else_if", "elem", "end", "entry", "gen", "get", "goal", "buf", "byte",
+	"size", "sign", "shift", "state", "str", "short_name", "double_it",
+	"ret", "result", "retval", "unit", "unsized", "volume", "vol", "while1",
+	"x", "y", "tmp", "next", "prev", "node", "data", "label", "offset",
+};
+static const size_t keyw_lookalikes_len = sizeof(keyw_lookalikes) / sizeof(char *);
+
+// Current time in nanoseconds.
+static inline uint64_t bench_nanos() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1000000000LLU + now.tv_nsec;
+}
+
+// Peak resident set size in KiB.
+static inline long bench_peak_rss() {
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+// Parses a size in bytes, which may be suffixed with K, M or G.
+static size_t bench_parse_size(const char *str, size_t fallback) {
+	char  *end;
+	size_t size = strtoull(str, &end, 0);
+	switch (*end) {
+		case 'k': case 'K': size <<= 10; break;
+		case 'm': case 'M': size <<= 20; break;
+		case 'g': case 'G': size <<= 30; break;
+	}
+	return size ? size : fallback;
+}
+
+// Classifies an identifier using the reference linear scan.
+static int keyw_linear(const char *str) {
+	for (size_t i = 0; i < keyw_map_len; i++) {
+		if (!strcmp(str, keyw_map[i].str)) {
+			return keyw_map[i].keyw;
+		}
+	}
+	return 0;
+}
+
+// Compares keyword classification by linear scan against tokeniser_keyword.
+static int bench_keywords(int argc, char **argv) {
+	size_t n_idents = argc >= 1 ? strtoull(argv[0], NULL, 0) : KEYW_BENCH_CORPUS;
+	if (!n_idents) n_idents = KEYW_BENCH_CORPUS;
+	
+	// Build an identifier-heavy corpus: roughly one in three is a keyword.
+	const char **idents = malloc(sizeof(char *) * n_idents);
+	size_t      *lens   = malloc(sizeof(size_t) * n_idents);
+	uint32_t seed = 0x1234567;
+	for (size_t i = 0; i < n_idents; i++) {
+		seed = seed * 1103515245 + 12345;
+		uint32_t rng = seed >> 8;
+		if (rng % 3 == 0) {
+			idents[i] = keyw_map[(rng / 3) % keyw_map_len].str;
+		} else {
+			idents[i] = keyw_lookalikes[(rng / 3) % keyw_lookalikes_len];
+		}
+		lens[i] = strlen(idents[i]);
+	}
+	
+	// Check both agree before timing anything.
+	for (size_t i = 0; i < n_idents; i++) {
+		if (keyw_linear(idents[i]) != tokeniser_keyword(idents[i], lens[i])) {
+			fprintf(stderr, "Keyword mismatch for '%s'\n", idents[i]);
+			return 1;
+		}
+	}
+	
+	// Time the linear scan.
+	volatile int sink = 0;
+	uint64_t t0 = bench_nanos();
+	for (int pass = 0; pass < KEYW_BENCH_PASSES; pass++) {
+		for (size_t i = 0; i < n_idents; i++) {
+			sink += keyw_linear(idents[i]);
+		}
+	}
+	uint64_t t_linear = bench_nanos() - t0;
+	
+	// Time the switch.
+	t0 = bench_nanos();
+	for (int pass = 0; pass < KEYW_BENCH_PASSES; pass++) {
+		for (size_t i = 0; i < n_idents; i++) {
+			sink += tokeniser_keyword(idents[i], lens[i]);
+		}
+	}
+	uint64_t t_switch = bench_nanos() - t0;
+	
+	double lookups = (double) n_idents * KEYW_BENCH_PASSES;
+	printf("Keyword classification, %zu identifiers x %d passes:\n", n_idents, KEYW_BENCH_PASSES);
+	printf("  linear scan:       %8.2f ns/ident\n", t_linear / lookups);
+	printf("  tokeniser_keyword: %8.2f ns/ident\n", t_switch / lookups);
+	printf("  speedup:           %8.2fx\n", (double) t_linear / t_switch);
+	
+	free(idents);
+	free(lens);
+	return 0;
+}
+
+// Writes a generated corpus to a file, or stdout.
+static int bench_corpus(int argc, char **argv) {
+	size_t size = argc >= 1 ? bench_parse_size(argv[0], FRONTEND_BENCH_SIZE) : FRONTEND_BENCH_SIZE;
+	FILE  *fd   = argc >= 2 ? fopen(argv[1], "w") : stdout;
+	if (!fd) {
+		perror(argv[1]);
+		return 1;
+	}
+	size_t len;
+	char  *corpus = corpus_generate(size, CORPUS_SEED, &len);
+	fwrite(corpus, 1, len, fd);
+	if (fd != stdout) fclose(fd);
+	free(corpus);
+	return 0;
+}
+
+// Times tokenise and yyparse separately over a generated corpus.
+static int bench_frontend(int argc, char **argv) {
+	size_t size = argc >= 1 ? bench_parse_size(argv[0], FRONTEND_BENCH_SIZE) : FRONTEND_BENCH_SIZE;
+	size_t len;
+	char  *corpus = corpus_generate(size, CORPUS_SEED, &len);
+	long   rss0   = bench_peak_rss();
+	
+	// Tokenise on its own.
+	tokeniser_ctx_t tkn_ctx;
+	tokeniser_init_cstr(&tkn_ctx, corpus);
+	tkn_ctx.filename = "<corpus>";
+	YYSTYPE  val;
+	size_t   n_tokens = 0;
+	uint64_t t0       = bench_nanos();
+	while (tokenise(&tkn_ctx, &val)) n_tokens ++;
+	uint64_t t_tokenise = bench_nanos() - t0;
+	size_t   n_lines    = tkn_ctx.y;
+	long     rss_tokenise = bench_peak_rss();
+	tokeniser_destroy(&tkn_ctx);
+	
+	// Parse from pre-lexed tokens, so yyparse is measured without the tokeniser or code generation.
+	flag_argparse("syntax-only");
+	tokeniser_init_cstr(&tkn_ctx, corpus);
+	tkn_ctx.filename = "<corpus>";
+	tokeniser_pretokenise(&tkn_ctx);
+	t0 = bench_nanos();
+	compile_c(tkn_ctx.filename, &tkn_ctx);
+	uint64_t t_parse   = bench_nanos() - t0;
+	long     rss_parse = bench_peak_rss();
+	tokeniser_destroy(&tkn_ctx);
+	
+	printf("Frontend, %zu byte corpus, %zu lines, %zu tokens:\n", len, n_lines, n_tokens);
+	// Peak RSS is process-wide, so a phase can only be judged by how much it raised the peak.
+	// For yyparse, that includes the pre-tokenised buffer.
+	printf("  tokenise: %10.3f ms  %8.2f Mtokens/s  %8.2f Mlines/s  cumulative peak RSS %6ld KiB (+%ld KiB)\n",
+		t_tokenise / 1e6, n_tokens * 1e3 / t_tokenise, n_lines * 1e3 / t_tokenise, rss_tokenise, rss_tokenise - rss0);
+	printf("  yyparse:  %10.3f ms  %8.2f Mtokens/s  %8.2f Mlines/s  cumulative peak RSS %6ld KiB (+%ld KiB)\n",
+		t_parse / 1e6, n_tokens * 1e3 / t_parse, n_lines * 1e3 / t_parse, rss_parse, rss_parse - rss_tokenise);
+	printf("  (peak RSS before either: %ld KiB)\n", rss0);
+	
+	free(corpus);
+	return 0;
+}
+
+// Run in benchmark mode (bench builds only).
+int mode_bench(int argc, char **argv) {
+	if (argc >= 2 && !strcmp(argv[1], "keywords")) {
+		return bench_keywords(argc - 2, argv + 2);
+	} else if (argc >= 2 && !strcmp(argv[1], "frontend")) {
+		return bench_frontend(argc - 2, argv + 2);
+	} else if (argc >= 2 && !strcmp(argv[1], "corpus")) {
+		return bench_corpus(argc - 2, argv + 2);
+	}
+	printf("%s --mode=bench <benchmark> [args...]\n", *argv);
+	printf("Benchmarks:\n");
+	printf("  keywords [n]\n");
+	printf("                Keyword classification over n identifiers.\n");
+	printf("  frontend [size]\n");
+	printf("                Tokeniser and parser throughput over a generated corpus.\n");
+	printf("  corpus [size] [file]\n");
+	printf("                Write a generated corpus of about size bytes, e.g. 1K to 100M.\n");
+	return 1;
+}
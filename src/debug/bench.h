@@ -0,0 +1,8 @@
+
+#ifndef BENCH_H
+#define BENCH_H
+
+// Run in benchmark mode (bench builds only).
+int mode_bench(int argc, char **argv);
+
+#endif //BENCH_H
@@ -0,0 +1,183 @@
+
+#include "corpus.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Output buffer and random state for the generator.
+typedef struct {
+	char    *buf;
+	size_t   len;
+	size_t   cap;
+	uint32_t seed;
+} corpus_t;
+
+// Variables every generated function has.
+static const char *corpus_vars[] = { "a", "b", "x", "y" };
+#define CORPUS_N_VARS (sizeof(corpus_vars) / sizeof(char *))
+
+// Binary operators that the generator handles reliably in any expression.
+// Shifts and logical operators are left out; the former can't yet take a variable amount,
+// the latter only work in conditions.
+static const char *corpus_binops[] = {
+	"+", "-", "*", "&", "|", "^",
+	"<", "<=", ">", ">=", "==", "!=",
+};
+#define CORPUS_N_BINOPS (sizeof(corpus_binops) / sizeof(char *))
+
+// Comparison operators for conditions.
+static const char *corpus_cmpops[] = {
+	"<", "<=", ">", ">=", "==", "!=",
+};
+#define CORPUS_N_CMPOPS (sizeof(corpus_cmpops) / sizeof(char *))
+
+// Assignment operators, as in testcase_assignment.c, less the shifts.
+static const char *corpus_assignops[] = {
+	"=", "+=", "-=", "*=", "^=", "|=", "&=",
+};
+#define CORPUS_N_ASSIGNOPS (sizeof(corpus_assignops) / sizeof(char *))
+
+// Next pseudo-random number.
+static inline uint32_t corpus_rand(corpus_t *corpus) {
+	corpus->seed = corpus->seed * 1103515245 + 12345;
+	return corpus->seed >> 8;
+}
+
+// Appends formatted text to the corpus.
+static void corpus_printf(corpus_t *corpus, const char *fmt, ...) {
+	va_list va;
+	while (1) {
+		va_start(va, fmt);
+		int n = vsnprintf(corpus->buf + corpus->len, corpus->cap - corpus->len, fmt, va);
+		va_end(va);
+		if (corpus->len + n < corpus->cap) {
+			corpus->len += n;
+			return;
+		}
+		corpus->cap *= 2;
+		corpus->buf  = realloc(corpus->buf, corpus->cap);
+		if (!corpus->buf) {printf("Out of memory\n"); abort();}
+	}
+}
+
+// Appends a random expression of at most the given depth.
+static void corpus_expr(corpus_t *corpus, int depth) {
+	uint32_t rng = corpus_rand(corpus);
+	if (depth <= 0 || rng % 3 == 0) {
+		// A leaf: variable or constant.
+		if (rng & 8) {
+			corpus_printf(corpus, "%s", corpus_vars[(rng >> 4) % CORPUS_N_VARS]);
+		} else if (rng & 16) {
+			corpus_printf(corpus, "0x%x", (rng >> 5) & 0xfff);
+		} else {
+			corpus_printf(corpus, "%u", (rng >> 5) % 100);
+		}
+	} else if (rng % 3 == 1) {
+		// A bracketed binary expression.
+		corpus_printf(corpus, "(");
+		corpus_expr(corpus, depth - 1);
+		corpus_printf(corpus, " %s ", corpus_binops[(rng >> 4) % CORPUS_N_BINOPS]);
+		corpus_expr(corpus, depth - 1);
+		corpus_printf(corpus, ")");
+	} else {
+		// A flat binary expression.
+		corpus_expr(corpus, depth - 1);
+		corpus_printf(corpus, " %s ", corpus_binops[(rng >> 4) % CORPUS_N_BINOPS]);
+		corpus_expr(corpus, depth - 1);
+	}
+}
+
+// Appends a random condition: comparisons joined by logical operators, as in test0.c.
+static void corpus_cond(corpus_t *corpus) {
+	uint32_t rng = corpus_rand(corpus);
+	corpus_printf(corpus, "%s %s %u", corpus_vars[rng % CORPUS_N_VARS], corpus_cmpops[(rng >> 2) % CORPUS_N_CMPOPS], (rng >> 5) % 100);
+	if (rng & (1 << 20)) {
+		corpus_printf(corpus, " %s ", (rng & (1 << 21)) ? "&&" : "||");
+		rng = corpus_rand(corpus);
+		corpus_printf(corpus, "%s %s %s", corpus_vars[rng % CORPUS_N_VARS], corpus_cmpops[(rng >> 2) % CORPUS_N_CMPOPS], corpus_vars[(rng >> 5) % CORPUS_N_VARS]);
+	}
+}
+
+// Appends a random simple statement.
+static void corpus_simple_stmt(corpus_t *corpus, const char *indent) {
+	uint32_t rng = corpus_rand(corpus);
+	size_t   op  = (rng >> 2) % CORPUS_N_ASSIGNOPS;
+	corpus_printf(corpus, "%s%s %s ", indent, corpus_vars[2 + rng % 2], corpus_assignops[op]);
+	// Keep compound assignments shallow, the generator runs out of registers on deeper ones.
+	corpus_expr(corpus, op ? 1 : 2);
+	corpus_printf(corpus, ";\n");
+}
+
+// Appends a random function, which may call the one defined before it.
+static void corpus_func(corpus_t *corpus, size_t id) {
+	corpus_printf(corpus, "// Generated function %zu.\n", id);
+	corpus_printf(corpus, "int func%zu(int a, int b) {\n", id);
+	corpus_printf(corpus, "\tint x = a, y = b;\n");
+	corpus_printf(corpus, "\tchar buf[8];\n");
+	
+	int n_stmts = 2 + corpus_rand(corpus) % 6;
+	for (int i = 0; i < n_stmts; i++) {
+		uint32_t rng = corpus_rand(corpus);
+		switch (rng % 5) {
+			case 0:
+				// If, else if, else, as in test_recursion.c.
+				corpus_printf(corpus, "\tif (");
+				corpus_cond(corpus);
+				corpus_printf(corpus, ") {\n");
+				corpus_simple_stmt(corpus, "\t\t");
+				corpus_printf(corpus, "\t} else if (x == %u) {\n", (rng >> 3) % 10);
+				corpus_simple_stmt(corpus, "\t\t");
+				corpus_printf(corpus, "\t} else {\n");
+				corpus_simple_stmt(corpus, "\t\t");
+				corpus_printf(corpus, "\t}\n");
+				break;
+			case 1:
+				// While loop.
+				corpus_printf(corpus, "\twhile (x < %u) {\n", (rng >> 3) % 1000);
+				corpus_printf(corpus, "\t\tx += %u;\n", 1 + (rng >> 13) % 9);
+				corpus_printf(corpus, "\t}\n");
+				break;
+			case 2:
+				// For loop over the array.
+				corpus_printf(corpus, "\tfor (int i = 0; i < 8; i++) {\n");
+				corpus_printf(corpus, "\t\tbuf[i] = 'a' + i;\n");
+				corpus_printf(corpus, "\t\ty ^= i;\n");
+				corpus_printf(corpus, "\t}\n");
+				break;
+			default:
+				corpus_simple_stmt(corpus, "\t");
+				break;
+		}
+	}
+	
+	if (id) {
+		// Call the previous function, as in test_recursion.c.
+		// Done last, as the generator does not reliably keep variables in registers across calls.
+		corpus_printf(corpus, "\ty = func%zu(x, y);\n", id - 1);
+	}
+	corpus_printf(corpus, "\treturn x + y;\n");
+	corpus_printf(corpus, "}\n\n");
+}
+
+// Generates roughly size bytes of synthetic C, built from the constructs used in test/*.c.
+// The same size and seed always give the same corpus.
+// Returns a NUL-terminated string to be freed by the caller, its length stored in *len_out.
+char *corpus_generate(size_t size, uint32_t seed, size_t *len_out) {
+	corpus_t corpus = {
+		.buf  = malloc(size + 4096),
+		.len  = 0,
+		.cap  = size + 4096,
+		.seed = seed,
+	};
+	if (!corpus.buf) {printf("Out of memory\n"); abort();}
+	
+	corpus_printf(&corpus, "// Synthetic benchmark corpus, seed %u.\n\n", seed);
+	for (size_t id = 0; corpus.len < size; id++) {
+		corpus_func(&corpus, id);
+	}
+	
+	if (len_out) *len_out = corpus.len;
+	return corpus.buf;
+}
@@ -0,0 +1,13 @@
+
+#ifndef CORPUS_H
+#define CORPUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Generates roughly size bytes of synthetic C, built from the constructs used in test/*.c.
+// The same size and seed always give the same corpus.
+// Returns a NUL-terminated string to be freed by the caller, its length stored in *len_out.
+char *corpus_generate(size_t size, uint32_t seed, size_t *len_out);
+
+#endif //CORPUS_H
@@ -12,6 +12,8 @@
 
 static void gen_test_expr();
 static void gen_test_func();
+static void gen_test_join();
+static void gen_test_parallel();
 
 void perform_gen_tests(int argc, char **argv) {
 	#ifdef EXPR_TEST
@@ -20,6 +22,12 @@ void perform_gen_tests(int argc, char **argv) {
 	#ifdef FUNC_TEST
 	gen_test_func();
 	#endif
+	#ifdef JOIN_TEST
+	gen_test_join();
+	#endif
+	#ifdef PARALLEL_TEST
+	gen_test_parallel();
+	#endif
 }
 
 static void gen_test_expr() {
@@ -27,3 +35,116 @@ static void gen_test_expr() {
 
 static void gen_test_func() {
 }
+
+// First half of the join test program.
+static void gen_test_join_a(asm_ctx_t *ctx) {
+	asm_use_sect(ctx, ".text", ASM_NOT_ALIGNED);
+	asm_write_label(ctx, "start");
+	asm_write_label_ref(ctx, "middle", 0, ASM_LABEL_REF_ABS_PTR);
+	for (memword_t i = 0; i < 300; i++) asm_write_memword(ctx, i);
+	asm_use_sect(ctx, ".data", ASM_NOT_ALIGNED);
+	asm_write_label(ctx, "value");
+	asm_write_memword(ctx, 0x1234);
+	asm_write_label_ref(ctx, "end", 0, ASM_LABEL_REF_ABS_PTR);
+}
+
+// Second half of the join test program, which refers to labels of the first half and vice versa.
+static void gen_test_join_b(asm_ctx_t *ctx) {
+	// Referenced first, so label ids differ from those of the first half.
+	asm_use_sect(ctx, ".data", ASM_NOT_ALIGNED);
+	asm_write_label_ref(ctx, "value", 1, ASM_LABEL_REF_ABS_PTR);
+	asm_use_sect(ctx, ".text", ASM_NOT_ALIGNED);
+	asm_write_label(ctx, "middle");
+	// Enough data to span multiple segments.
+	for (memword_t i = 0; i < 1000; i++) asm_write_memword(ctx, ~i);
+	asm_write_label_ref(ctx, "start", 0, ASM_LABEL_REF_ABS_PTR);
+	asm_write_label(ctx, "end");
+	asm_write_zero(ctx, 20);
+	asm_write_memword(ctx, 0x5678);
+	asm_use_sect(ctx, ".bss", ASM_NOT_ALIGNED);
+	asm_write_zero(ctx, 100);
+}
+
+// Runs output_native into memory.
+static size_t gen_test_output(asm_ctx_t *ctx, char **image) {
+	size_t len = 0;
+	ctx->out_fd        = open_memstream(image, &len);
+	ctx->out_addr2line = NULL;
+	if (!output_native(ctx)) fprintf(stderr, "Test output failed!\n");
+	fclose(ctx->out_fd);
+	return len;
+}
+
+static void gen_test_join() {
+	// The same program, once in one context and once joined from two.
+	asm_ctx_t single, joined, extra;
+	asm_init(&single);
+	gen_test_join_a(&single);
+	gen_test_join_b(&single);
+	asm_init(&joined);
+	asm_init(&extra);
+	gen_test_join_a(&joined);
+	gen_test_join_b(&extra);
+	if (!asm_join(&joined, &extra)) fprintf(stderr, "Join test reported a duplicate label!\n");
+	
+	char  *single_image, *joined_image;
+	size_t single_len = gen_test_output(&single, &single_image);
+	size_t joined_len = gen_test_output(&joined, &joined_image);
+	if (single_len != joined_len || memcmp(single_image, joined_image, single_len)) {
+		fprintf(stderr, "Join test output differs!\n");
+	}
+	free(single_image);
+	free(joined_image);
+	
+	// Labels defined on both sides are an error.
+	asm_ctx_t dup;
+	asm_init(&dup);
+	gen_test_join_a(&dup);
+	if (asm_join(&joined, &dup)) fprintf(stderr, "Join test missed a duplicate label!\n");
+}
+
+// Program for the parallel test, big enough to span many segments in each section.
+static void gen_test_parallel_prog(asm_ctx_t *ctx) {
+	char label[16];
+	for (memword_t i = 0; i < 1200; i++) {
+		asm_use_sect(ctx, ".text", ASM_NOT_ALIGNED);
+		sprintf(label, "f%u", i);
+		asm_write_label(ctx, label);
+		for (memword_t j = 0; j < 20; j++) asm_write_memword(ctx, i ^ j);
+		// Refer to code both before and after this, which may be in other segments.
+		sprintf(label, "f%u", (i * 7) % 1200);
+		asm_write_label_ref(ctx, label, 0, ASM_LABEL_REF_ABS_PTR);
+		sprintf(label, "d%u", (i * 13) % 1200);
+		asm_write_label_ref(ctx, label, 2, ASM_LABEL_REF_ABS_PTR);
+		asm_use_sect(ctx, ".data", ASM_NOT_ALIGNED);
+		sprintf(label, "d%u", i);
+		asm_write_label(ctx, label);
+		asm_write_memword(ctx, i);
+		asm_write_zero(ctx, 3);
+		sprintf(label, "f%u", 1199 - i);
+		asm_write_label_ref(ctx, label, 1, ASM_LABEL_REF_ABS_PTR);
+	}
+	asm_use_sect(ctx, ".bss", ASM_NOT_ALIGNED);
+	asm_write_zero(ctx, 100);
+}
+
+static void gen_test_parallel() {
+	// The same program, once reduced serially and once over several threads.
+	asm_ctx_t serial, threaded;
+	asm_init(&serial);
+	gen_test_parallel_prog(&serial);
+	asm_init(&threaded);
+	gen_test_parallel_prog(&threaded);
+	
+	char  *serial_image, *threaded_image;
+	asm_ppc_threads = 1;
+	size_t serial_len   = gen_test_output(&serial, &serial_image);
+	asm_ppc_threads = 8;
+	size_t threaded_len = gen_test_output(&threaded, &threaded_image);
+	asm_ppc_threads = 0;
+	if (serial_len != threaded_len || memcmp(serial_image, threaded_image, serial_len)) {
+		fprintf(stderr, "Parallel test output differs!\n");
+	}
+	free(serial_image);
+	free(threaded_image);
+}
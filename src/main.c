@@ -16,6 +16,10 @@
 
 #include "ctxalloc.h"
 
+#ifdef ENABLE_BENCH
+#include "bench.h"
+#endif
+
 #include "stdlib.h"
 #include "errno.h"
 
@@ -41,6 +45,12 @@ int main(int argc, char **argv) {
 		argv[1] = argv[0];
 		return mode_addr2line(argc-1, argv+1);
 		
+#ifdef ENABLE_BENCH
+	} else if (argc >= 2 && !strcmp(argv[1], "--mode=bench")) {
+		argv[1] = argv[0];
+		return mode_bench(argc-1, argv+1);
+		
+#endif
 	}
 	
 	// Check for mode by name.
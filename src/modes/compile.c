@@ -5,6 +5,7 @@
 #include "fcntl.h"
 #include "stdlib.h"
 #include "unistd.h"
+#include "sys/stat.h"
 
 #include "array_util.h"
 #include "parser.h"
@@ -20,14 +21,24 @@ typedef struct options {
 	char **includeDirs;
 	char *outputFile;
 	char *linenumFile;
+	bool dumpHex;
 } options_t;
 
+// Whether to tokenise sources in full before parsing them.
+static bool pretokenise = false;
+// Whether to stop after checking syntax, without generating code.
+static bool syntax_only = false;
+
 // Show help on the command line.
 static void show_help     (int argc, char **argv);
 // Parse options using argv.
 static void parse_options (options_t *options, int argc, char **argv);
 // Apply default options for options not already set.
 static void apply_defaults(options_t *options);
+// Print allocation statistics, at exit.
+static void alloc_report  ();
+// Remove a failed output file, unless it isn't a regular file.
+static void remove_output (const char *path);
 
 
 
@@ -44,6 +55,7 @@ int mode_compile(int argc, char **argv) {
 		.includeDirs    = NULL,
 		.outputFile     = NULL,
 		.linenumFile    = NULL,
+		.dumpHex        = false,
 	};
 	
 	parse_options(&options, argc, argv);
@@ -69,6 +81,7 @@ int mode_compile(int argc, char **argv) {
 	
 	// Compile first of the inputs.
 	asm_ctx_t *ctx = compile(options.sourceFiles[0], NULL);
+	if (syntax_only) return 0;
 	
 	// Open output file.
 	ctx->out_fd = fopen(options.outputFile, "wb");
@@ -88,16 +101,22 @@ int mode_compile(int argc, char **argv) {
 		ctx->out_addr2line = NULL;
 	}
 	
+	// Hex dump of the output, straight from memory.
+	ctx->out_hexdump = options.dumpHex ? stdout : NULL;
+	
 	// Output datas.
-	output_native(ctx);
+	bool success = output_native(ctx);
 	
 	// Clean up.
 	fclose(ctx->out_fd);
 	if (ctx->out_addr2line) fclose(ctx->out_addr2line);
+	if (!success) {
+		// Don't leave empty or partial outputs behind.
+		remove_output(options.outputFile);
+		if (options.linenumFile) remove_output(options.linenumFile);
+		return 1;
+	}
 	
-	char tmp[34+strlen(options.outputFile)];
-	snprintf(tmp, sizeof(tmp), "hexdump -ve '8/2 \"%%04X \" \"\n\"' '%s'", options.outputFile);
-	system(tmp);
 	return 0;
 }
 
@@ -167,6 +186,10 @@ static void parse_options(options_t *options, int argc, char **argv) {
 				options->abort = true;
 			}
 			
+		} else if (!strcmp(argv[argIndex], "--dump-hex")) {
+			// Print the output in hexadecimal.
+			options->dumpHex = true;
+			
 		} else if (!strncmp(argv[argIndex], "--include=", 10)) {
 			// Add include directory.
 			options->numIncludeDirs ++;
@@ -187,6 +210,15 @@ static void parse_options(options_t *options, int argc, char **argv) {
 				options->abort = true;
 			}
 			
+		} else if (!strcmp(argv[argIndex], "--alloc-report")) {
+			// Report where memory went at exit.
+			alloc_stats_enable();
+			atexit(alloc_report);
+			
+		} else if (!strcmp(argv[argIndex], "-")) {
+			// Standard input.
+			array_len_concat(global_alloc, char *, options->sourceFiles, options->numSourceFiles, argv[argIndex]);
+			
 		} else if (*argv[argIndex] == '-') {
 			// Unknown option.
 			fflush(stdout);
@@ -204,6 +236,7 @@ static void parse_options(options_t *options, int argc, char **argv) {
 // Show help on the command line.
 static void show_help(int argc, char **argv) {
 	printf("%s [--mode=...] [options] source-files...\n", *argv);
+	printf("A source file of '-' reads C from standard input.\n");
 	printf("Options:\n");
 	printf("  --mode=<compile|addr2line>\n");
 	printf("                Specify the application mode, default is compile.\n");
@@ -215,6 +248,14 @@ static void show_help(int argc, char **argv) {
 	printf("                Specify the output file path.\n");
 	printf("  -I<dir>  --include=<dir>\n");
 	printf("                Add a directory to the include directories.\n");
+	printf("  -fpretokenise\n");
+	printf("                Tokenise each source in full before parsing it.\n");
+	printf("  -fsyntax-only\n");
+	printf("                Check the sources for errors without generating any output.\n");
+	printf("  --dump-hex\n");
+	printf("                Print the output in hexadecimal after compiling.\n");
+	printf("  --alloc-report\n");
+	printf("                Report where memory was allocated when exiting.\n");
 }
 
 // Apply default options for options not already set.
@@ -224,6 +265,19 @@ static void apply_defaults(options_t *options) {
 	}
 }
 
+// Print allocation statistics, at exit.
+static void alloc_report() {
+	fflush(stdout);
+	alloc_stats_report(stderr);
+}
+
+// Remove a failed output file, unless it isn't a regular file.
+// Outputs like /dev/null must survive a failed compile.
+static void remove_output(const char *path) {
+	struct stat statbuf;
+	if (!stat(path, &statbuf) && S_ISREG(statbuf.st_mode)) remove(path);
+}
+
 // Parse -f arguments, the '-f' removed.
 // Returns true on success.
 bool flag_argparse(const char *arg) {
@@ -243,7 +297,14 @@ bool flag_argparse(const char *arg) {
 		#else
 		printf("Error: -f%s is not supported by %s.", arg, ARCH_ID);
 		#endif
+	} else if (!strcmp(arg, "pretokenise")) {
+		pretokenise = true;
+	} else if (!strcmp(arg, "no-pretokenise")) {
+		pretokenise = false;
+	} else if (!strcmp(arg, "syntax-only")) {
+		syntax_only = true;
 	}
+	return true;
 }
 
 
@@ -251,7 +312,10 @@ bool flag_argparse(const char *arg) {
 // Compile a file of unknown type.
 asm_ctx_t *compile(char *filename, tokeniser_ctx_t *tkn_ctx) {
 	char *dot = strrchr(filename, '.');
-	if (!dot) {
+	if (!strcmp(filename, "-")) {
+		// Standard input is assumed to be C.
+		return compile_c(filename, tkn_ctx);
+	} else if (!dot) {
 		printf("%s: Filetype not recognised.\n", filename);
 		return NULL;
 	} else if (!strcmp(dot, ".c")) {
@@ -272,7 +336,12 @@ asm_ctx_t *compile_c(char *filename, tokeniser_ctx_t *tokeniser_ctx) {
 	// Open file, if any.
 	if (!tokeniser_ctx) {
 		tokeniser_ctx = &dummy;
-		fd = fopen(filename, "r");
+		if (!strcmp(filename, "-")) {
+			fd       = stdin;
+			filename = "<stdin>";
+		} else {
+			fd = fopen(filename, "r");
+		}
 		if (!fd) {
 			printf("Cannot open %s: %s\n", filename, strerror(errno));
 			return NULL;
@@ -286,18 +355,20 @@ asm_ctx_t *compile_c(char *filename, tokeniser_ctx_t *tokeniser_ctx) {
 	asm_ctx_t       asm_ctx;
 	ctx.tokeniser_ctx = tokeniser_ctx;
 	ctx.asm_ctx       = &asm_ctx;
-	ctx.allocator     = alloc_create(ALLOC_NO_PARENT);
+	ctx.allocator     = alloc_create_arena(ALLOC_NO_PARENT);
 	ctx.n_const       = 0;
+	ctx.tkn_pos       = (pos_t) {0};
 	asm_init(&asm_ctx);
 	asm_ctx.tokeniser_ctx = tokeniser_ctx;
 	
 	// Parse and compile C.
+	if (pretokenise) tokeniser_pretokenise(tokeniser_ctx);
 	yyparse(&ctx);
 	
 	// Clean up.
 	alloc_destroy(ctx.allocator);
 	if (fd) {
-		fclose(fd);
+		if (fd != stdin) fclose(fd);
 		tokeniser_destroy(tokeniser_ctx);
 	}
 	
@@ -341,14 +412,15 @@ asm_ctx_t *assemble_s(char *filename, tokeniser_ctx_t *tokeniser_ctx) {
 
 
 // Callback from bison, asking for more tokens.
-int yylex(parser_ctx_t *ctx) {
-	int tkn = tokenise(ctx->tokeniser_ctx);
+int yylex(YYSTYPE *lval, parser_ctx_t *ctx) {
+	int tkn = tokenise(ctx->tokeniser_ctx, lval);
+	if (tkn) ctx->tkn_pos = lval->pos;
 	return tkn;
 }
 
 // Callback from bison, reporting errors.
 void yyerror(parser_ctx_t *ctx, char *msg) {
-	report_error(ctx->tokeniser_ctx, E_ERROR, yylval.pos, msg);
+	report_error(ctx->tokeniser_ctx, E_ERROR, ctx->tkn_pos, msg);
 }
 
 
@@ -372,7 +444,7 @@ static bool func_incompatible(parser_ctx_t *ctx, funcdef_t *func, funcdef_t *old
 // Process a function.
 void function_added(parser_ctx_t *ctx, funcdef_t *func) {
 	// Defined.
-	funcdef_t *repl = map_get(&ctx->asm_ctx->functions, func->ident.strval);
+	funcdef_t *repl = map_get_interned(&ctx->asm_ctx->functions, func->ident.strval);
 	// Check for pre-existing definitions.
 	if (repl && func_incompatible(ctx, func, repl)) {
 		// Exclaim the error.
@@ -381,10 +453,11 @@ void function_added(parser_ctx_t *ctx, funcdef_t *func) {
 		// Abort code generation.
 		return;
 	} else {
-		// Put in MAP.
-		map_set(&ctx->asm_ctx->functions, func->ident.strval, func);
+		// Put in MAP; the caller's copy lives on the parser stack.
+		func = XCOPY(ctx->allocator, func, funcdef_t);
+		map_set_interned(&ctx->asm_ctx->functions, func->ident.strval, func);
 	}
 	// Gen some CODE boi.
-	if (func->stmts)
+	if (func->stmts && !syntax_only)
 		gen_function(ctx->asm_ctx, func);
 }
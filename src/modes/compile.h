@@ -23,7 +23,7 @@ asm_ctx_t *compile_c     (char *filename, tokeniser_ctx_t *tkn_ctx);
 asm_ctx_t *assemble_s    (char *filename, tokeniser_ctx_t *tkn_ctx);
 
 // Bison tokeniser callback.
-int  yylex  (parser_ctx_t *ctx);
+int  yylex  (union YYSTYPE *lval, parser_ctx_t *ctx);
 // Bison error callback.
 void yyerror(parser_ctx_t *ctx, char *msg);
 
@@ -59,6 +59,8 @@ struct parser_ctx {
 	alloc_ctx_t      allocator;
 	// Most recently used simple type.
 	simple_type_t    s_type;
+	// Position of the most recent token, for syntax errors.
+	pos_t            tkn_pos;
 };
 
 // Integer constant; mostly used in expressions.
@@ -1,10 +1,44 @@
 
 #include "tokeniser.h"
 #include "parser.h"
+#include "array_util.h"
+#include "intern.h"
 #include <stdlib.h>
 #include <stdint.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "ctxalloc_warn.h"
 
+// Size of the ring buffer used to stream sources that can't be mapped.
+// Also bounds how far ahead the tokeniser can look.
+#define TKN_RING_SIZE 65536
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+// Number of bytes scanned at once by the bulk skipping functions.
+#define TKN_VEC_WIDTH 32
+// Mask value for a vector in which every byte matched.
+#define TKN_VEC_FULL  0xffffffffU
+typedef __m256i tkn_vec_t;
+#define tkn_vec_load(ptr)  _mm256_loadu_si256((const __m256i *) (ptr))
+#define tkn_vec_eq(vec, c) _mm256_cmpeq_epi8((vec), _mm256_set1_epi8(c))
+#define tkn_vec_or(a, b)   _mm256_or_si256((a), (b))
+#define tkn_vec_mask(vec)  ((uint32_t) _mm256_movemask_epi8(vec))
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+// Number of bytes scanned at once by the bulk skipping functions.
+#define TKN_VEC_WIDTH 16
+// Mask value for a vector in which every byte matched.
+#define TKN_VEC_FULL  0xffffU
+typedef __m128i tkn_vec_t;
+#define tkn_vec_load(ptr)  _mm_loadu_si128((const __m128i *) (ptr))
+#define tkn_vec_eq(vec, c) _mm_cmpeq_epi8((vec), _mm_set1_epi8(c))
+#define tkn_vec_or(a, b)   _mm_or_si128((a), (b))
+#define tkn_vec_mask(vec)  ((uint32_t) _mm_movemask_epi8(vec))
+#endif
+
 pos_t pos_merge(pos_t one, pos_t two) {
 	if (one.index0 > two.index0) {
 		pos_t temp = one;
@@ -51,34 +85,76 @@ void tokeniser_init_cstr(tokeniser_ctx_t *ctx, char *raw) {
 	*ctx = (tokeniser_ctx_t) {
 		.filename = "<anonymous>",
 		.source_len = strlen(raw),
+		.is_mapped = false,
 		.fd = NULL,
 		.use_fd = false,
+		.ring = NULL,
+		.ring_cap = 0,
+		.ring_end = 0,
+		.ring_eof = false,
 		.index = 0,
 		.x = 0,
 		.y = 1,
+		.line_starts = NULL,
+		.line_starts_len = 0,
+		.line_starts_cap = 0,
+		.line_starts_dropped = 0,
+		.buf = NULL,
+		.err_msg = NULL,
 		.allocator = alloc_create(ALLOC_NO_PARENT),
 	};
-	ctx->source = xalloc(ctx->allocator, strlen(raw));
+	ctx->source = xalloc(ctx->allocator, ctx->source_len + 1);
 	strcpy(ctx->source, raw);
 }
 
 // Initialise a context, given a file descriptor.
+// Maps the file into memory, or streams it if mapping is not possible.
 void tokeniser_init_file(tokeniser_ctx_t *ctx, FILE *file) {
 	*ctx = (tokeniser_ctx_t) {
 		.filename = "<anonymous>",
 		.source = NULL,
 		.source_len = 0,
+		.is_mapped = false,
 		.fd = file,
-		.use_fd = true,
+		.use_fd = false,
+		.ring = NULL,
+		.ring_cap = 0,
+		.ring_end = 0,
+		.ring_eof = false,
 		.index = 0,
 		.x = 0,
 		.y = 1,
+		.line_starts = NULL,
+		.line_starts_len = 0,
+		.line_starts_cap = 0,
+		.line_starts_dropped = 0,
+		.buf = NULL,
+		.err_msg = NULL,
 		.allocator = alloc_create(ALLOC_NO_PARENT),
 	};
+	
+	// Try to map regular files.
+	struct stat statbuf;
+	bool is_reg = !fstat(fileno(file), &statbuf) && S_ISREG(statbuf.st_mode);
+	if (is_reg && statbuf.st_size > 0) {
+		void *map = mmap(NULL, statbuf.st_size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+		if (map != MAP_FAILED) {
+			ctx->source     = map;
+			ctx->source_len = statbuf.st_size;
+			ctx->is_mapped  = true;
+			return;
+		}
+	}
+	
+	// Fall back to streaming the file, which also works for pipes.
+	ctx->use_fd   = true;
+	ctx->ring_cap = TKN_RING_SIZE;
+	ctx->ring     = xalloc(ctx->allocator, ctx->ring_cap);
 }
 
 // Clean up a tokeniser context.
 void tokeniser_destroy(tokeniser_ctx_t *ctx) {
+	if (ctx->is_mapped) munmap(ctx->source, ctx->source_len);
 	alloc_destroy(ctx->allocator);
 }
 
@@ -119,12 +195,117 @@ bool is_alphanumeric(char c) {
 }
 
 
+// Reads from fd until the character at index is in the ring buffer.
+// Never overwrites characters not yet consumed, nor the last one consumed,
+// so index must lie less than TKN_RING_SIZE - 1 past ctx->index.
+// Returns false at the end of the input or past the lookahead window.
+static bool tokeniser_fill(tokeniser_ctx_t *ctx, size_t index) {
+	while (index >= ctx->ring_end) {
+		if (ctx->ring_eof || index - ctx->index >= ctx->ring_cap - 1) return false;
+		// Read as much as fits without wrapping or overwriting what must be kept.
+		size_t off = ctx->ring_end & (ctx->ring_cap - 1);
+		size_t cap = ctx->ring_cap - 1 - (ctx->ring_end - ctx->index);
+		if (cap > ctx->ring_cap - off) cap = ctx->ring_cap - off;
+		ssize_t n;
+		do {
+			n = read(fileno(ctx->fd), ctx->ring + off, cap);
+		} while (n < 0 && errno == EINTR);
+		if (n <= 0) {
+			ctx->ring_eof = true;
+			return false;
+		}
+		ctx->ring_end += n;
+	}
+	return true;
+}
+
+// Whether the character at index of a streamed source can still be read.
+static inline bool tokeniser_in_ring(tokeniser_ctx_t *ctx, size_t index) {
+	return index + ctx->ring_cap >= ctx->ring_end && (index < ctx->ring_end || tokeniser_fill(ctx, index));
+}
+
+// Gets the character at index from the source without converting line endings.
+// Returns 0 past the end of the source.
+static inline char tokeniser_raw_at(tokeniser_ctx_t *ctx, size_t index) {
+	if (ctx->use_fd) {
+		if (!tokeniser_in_ring(ctx, index)) return 0;
+		return ctx->ring[index & (ctx->ring_cap - 1)];
+	} else {
+		return index < ctx->source_len ? ctx->source[index] : 0;
+	}
+}
+
+// Forgets the lines of a streamed source that are no longer in the ring, keeping at least the last one.
+// The token buffer needs every line, so nothing is forgotten when pre-tokenising.
+static void tokeniser_drop_lines(tokeniser_ctx_t *ctx) {
+	if (!ctx->use_fd || ctx->buf) return;
+	size_t drop = 0;
+	while (drop < ctx->line_starts_len - 1 && ctx->line_starts[drop] + ctx->ring_cap < ctx->ring_end) drop++;
+	if (!drop) return;
+	memmove(ctx->line_starts, ctx->line_starts + drop, sizeof(size_t) * (ctx->line_starts_len - drop));
+	ctx->line_starts_len     -= drop;
+	ctx->line_starts_dropped += drop;
+}
+
+// Records the start index of a line, if it is the next line not yet known.
+static inline void tokeniser_mark_line(tokeniser_ctx_t *ctx, int line, size_t index) {
+	if (!ctx->line_starts_len && !ctx->line_starts_dropped) {
+		array_len_cap_concat(ctx->allocator, size_t, ctx->line_starts, ctx->line_starts_cap, ctx->line_starts_len, 0);
+	}
+	if (line - 1 == ctx->line_starts_dropped + ctx->line_starts_len) {
+		// Make room by dropping old lines before growing the table.
+		if (ctx->line_starts_len == ctx->line_starts_cap) tokeniser_drop_lines(ctx);
+		array_len_cap_concat(ctx->allocator, size_t, ctx->line_starts, ctx->line_starts_cap, ctx->line_starts_len, index);
+	}
+}
+
+// Finds the index at which a line starts.
+// Extends the line table past what has been read so far if needed.
+// Returns false if the source has fewer lines.
+static bool tokeniser_find_line(tokeniser_ctx_t *ctx, int line, size_t *out) {
+	if (line < 1 || line <= ctx->line_starts_dropped) return false;
+	tokeniser_mark_line(ctx, 1, 0);
+	
+	if (line > ctx->line_starts_dropped + ctx->line_starts_len) {
+		// Scan on from the last line known.
+		int    known = ctx->line_starts_dropped + ctx->line_starts_len;
+		size_t index = ctx->line_starts[ctx->line_starts_len - 1];
+		if (ctx->use_fd) {
+			// Streamed source; only what is still in the ring can be scanned.
+			for (; known < line && tokeniser_in_ring(ctx, index); index++) {
+				char c = ctx->ring[index & (ctx->ring_cap - 1)];
+				if (c == '\r') {
+					bool crlf = tokeniser_raw_at(ctx, index + 1) == '\n';
+					tokeniser_mark_line(ctx, ++known, crlf ? index + 2 : index + 1);
+				} else if (c == '\n') {
+					tokeniser_mark_line(ctx, ++known, index + 1);
+				}
+			}
+		} else {
+			// In-memory source.
+			for (; known < line && index < ctx->source_len; index++) {
+				char c = ctx->source[index];
+				if (c == '\r') {
+					bool crlf = index + 1 < ctx->source_len && ctx->source[index + 1] == '\n';
+					tokeniser_mark_line(ctx, ++known, crlf ? index + 2 : index + 1);
+				} else if (c == '\n') {
+					tokeniser_mark_line(ctx, ++known, index + 1);
+				}
+			}
+		}
+		if (line > ctx->line_starts_dropped + ctx->line_starts_len) return false;
+	}
+	
+	*out = ctx->line_starts[line - 1 - ctx->line_starts_dropped];
+	return true;
+}
+
 // Read a single character.
 char tokeniser_readchar(tokeniser_ctx_t *ctx) {
 	char c;
 	if (ctx->use_fd) {
-		size_t n = fread(&c, 1, 1, ctx->fd);
-		if (!n) return 0;
+		if (!tokeniser_in_ring(ctx, ctx->index)) return 0;
+		c = ctx->ring[ctx->index & (ctx->ring_cap - 1)];
 	} else {
 		if (ctx->index >= ctx->source_len) {
 			return 0;
@@ -135,15 +316,131 @@ char tokeniser_readchar(tokeniser_ctx_t *ctx) {
 	ctx->x ++;
 	if (c == '\r') {
 		c = '\n';
-		if (tokeniser_nextchar(ctx) == '\n') tokeniser_readchar(ctx);
+		// Check the raw character; tokeniser_nextchar would also turn a '\r' into '\n'.
+		if (tokeniser_raw_at(ctx, ctx->index) == '\n') tokeniser_readchar(ctx);
 	}
 	if (c == '\n') {
 		ctx->y ++;
 		ctx->x = 0;
+		tokeniser_mark_line(ctx, ctx->y, ctx->index);
 	}
 	return c;
 }
 
+// Length of the run of ' ', '\t' and '\n' at the start of the buffer.
+static size_t tokeniser_span_space(const char *buf, size_t len) {
+	size_t i = 0;
+#ifdef TKN_VEC_WIDTH
+	for (; i + TKN_VEC_WIDTH <= len; i += TKN_VEC_WIDTH) {
+		tkn_vec_t vec  = tkn_vec_load(buf + i);
+		uint32_t  mask = tkn_vec_mask(tkn_vec_or(tkn_vec_or(tkn_vec_eq(vec, ' '), tkn_vec_eq(vec, '\t')), tkn_vec_eq(vec, '\n')));
+		if (mask != TKN_VEC_FULL) return i + __builtin_ctz(~mask);
+	}
+#endif
+	while (i < len && (buf[i] == ' ' || buf[i] == '\t' || buf[i] == '\n')) i++;
+	return i;
+}
+
+// Length of the run at the start of the buffer that contains none of a, b and c.
+static size_t tokeniser_span_until(const char *buf, size_t len, char a, char b, char c) {
+	size_t i = 0;
+#ifdef TKN_VEC_WIDTH
+	for (; i + TKN_VEC_WIDTH <= len; i += TKN_VEC_WIDTH) {
+		tkn_vec_t vec  = tkn_vec_load(buf + i);
+		uint32_t  mask = tkn_vec_mask(tkn_vec_or(tkn_vec_or(tkn_vec_eq(vec, a), tkn_vec_eq(vec, b)), tkn_vec_eq(vec, c)));
+		if (mask) return i + __builtin_ctz(mask);
+	}
+#endif
+	while (i < len && buf[i] != a && buf[i] != b && buf[i] != c) i++;
+	return i;
+}
+
+// Consumes n characters at once, buf being where the next character is in memory.
+// The characters may contain '\n' but not '\r', which tokeniser_readchar must handle.
+// Equivalent to calling tokeniser_readchar n times.
+static void tokeniser_advance(tokeniser_ctx_t *ctx, const char *buf, size_t n) {
+	// Offset of the character after the last newline, if any.
+	size_t line_start = 0;
+	bool   has_nl     = false;
+	size_t i = 0;
+#ifdef TKN_VEC_WIDTH
+	for (; i + TKN_VEC_WIDTH <= n; i += TKN_VEC_WIDTH) {
+		uint32_t nl = tkn_vec_mask(tkn_vec_eq(tkn_vec_load(buf + i), '\n'));
+		if (!nl) continue;
+		// Count the lines in bulk, only walking them if the line table needs them.
+		int count = __builtin_popcount(nl);
+		if (ctx->line_starts_dropped + ctx->line_starts_len < ctx->y + count) {
+			for (uint32_t bits = nl; bits; bits &= bits - 1) {
+				tokeniser_mark_line(ctx, ctx->y + 1, ctx->index + i + __builtin_ctz(bits) + 1);
+				ctx->y ++;
+			}
+		} else {
+			ctx->y += count;
+		}
+		line_start = i + 32 - __builtin_clz(nl);
+		has_nl     = true;
+	}
+#endif
+	for (; i < n; i++) {
+		if (buf[i] == '\n') {
+			ctx->y ++;
+			tokeniser_mark_line(ctx, ctx->y, ctx->index + i + 1);
+			line_start = i + 1;
+			has_nl     = true;
+		}
+	}
+	
+	// Update column and index.
+	if (has_nl) {
+		ctx->x  = n - line_start;
+	} else {
+		ctx->x += n;
+	}
+	ctx->index += n;
+}
+
+// Gets the run of characters that can be read without copying, starting at the current position.
+// Returns the amount of characters available at *buf, which is 0 at the end of the source.
+static inline size_t tokeniser_window(tokeniser_ctx_t *ctx, const char **buf) {
+	if (ctx->use_fd) {
+		if (!tokeniser_in_ring(ctx, ctx->index)) return 0;
+		// Stop at the end of the ring, the rest is at the start.
+		size_t off = ctx->index & (ctx->ring_cap - 1);
+		size_t len = ctx->ring_end - ctx->index;
+		*buf = ctx->ring + off;
+		return len < ctx->ring_cap - off ? len : ctx->ring_cap - off;
+	} else {
+		*buf = ctx->source + ctx->index;
+		return ctx->source_len - ctx->index;
+	}
+}
+
+// Skips whitespace other than '\r' in bulk.
+static inline void tokeniser_skip_space(tokeniser_ctx_t *ctx) {
+	const char *buf;
+	size_t len, n;
+	do {
+		len = tokeniser_window(ctx, &buf);
+		n   = tokeniser_span_space(buf, len);
+		tokeniser_advance(ctx, buf, n);
+	} while (n && n == len);
+}
+
+// Skips characters in bulk up to the first of a, b or c.
+// One of a, b and c must be '\r', which tokeniser_advance cannot skip.
+// Returns the amount of characters skipped.
+static inline size_t tokeniser_skip_until(tokeniser_ctx_t *ctx, char a, char b, char c) {
+	const char *buf;
+	size_t len, n, total = 0;
+	do {
+		len = tokeniser_window(ctx, &buf);
+		n   = tokeniser_span_until(buf, len, a, b, c);
+		tokeniser_advance(ctx, buf, n);
+		total += n;
+	} while (n && n == len);
+	return total;
+}
+
 // Identical to tokeniser_nextchar_no(0).
 char tokeniser_nextchar(tokeniser_ctx_t *ctx) {
 	return tokeniser_nextchar_no(ctx, 0);
@@ -152,12 +449,10 @@ char tokeniser_nextchar(tokeniser_ctx_t *ctx) {
 // Next character + offset.
 char tokeniser_nextchar_no(tokeniser_ctx_t *ctx, int no) {
 	if (ctx->use_fd) {
-		long pos = ftell(ctx->fd);
-		fseek(ctx->fd, no, SEEK_CUR);
-		char c;
-		size_t n = fread(&c, 1, 1, ctx->fd);
-		fseek(ctx->fd, pos, SEEK_SET);
-		if (!n) return 0;
+		// Lookahead is bounded by the size of the ring.
+		if (!tokeniser_in_ring(ctx, ctx->index + no)) return 0;
+		char c = ctx->ring[(ctx->index + no) & (ctx->ring_cap - 1)];
+		if (c == '\r') c = '\n';
 		return c;
 	} else {
 		if (ctx->index + no >= ctx->source_len) {
@@ -298,47 +593,64 @@ char *tokeniser_getstr(tokeniser_ctx_t *ctx, char term) {
 	return buf;
 }
 
-typedef struct {
-	int keyw;
-	char *str;
-} keyw_map_t;
-
-static const keyw_map_t keyw_map[] = {
-	// (keyw_map_t) { .keyw=TKN_, .str="" },
-	(keyw_map_t) { .keyw=TKN_VOID,     .str="void" },
-	(keyw_map_t) { .keyw=TKN_SHORT,    .str="short" },
-	(keyw_map_t) { .keyw=TKN_INT,      .str="int" },
-	(keyw_map_t) { .keyw=TKN_LONG,     .str="long" },
-	(keyw_map_t) { .keyw=TKN_CHAR,     .str="char" },
-	(keyw_map_t) { .keyw=TKN_FLOAT,    .str="float" },
-	(keyw_map_t) { .keyw=TKN_DOUBLE,   .str="double" },
-	(keyw_map_t) { .keyw=TKN_BOOL,     .str="bool" },
-	(keyw_map_t) { .keyw=TKN_SIGNED,   .str="signed" },
-	(keyw_map_t) { .keyw=TKN_UNSIGNED, .str="unsigned" },
-	(keyw_map_t) { .keyw=TKN_IF,       .str="if" },
-	(keyw_map_t) { .keyw=TKN_ELSE,     .str="else" },
-	(keyw_map_t) { .keyw=TKN_WHILE,    .str="while" },
-	(keyw_map_t) { .keyw=TKN_FOR,      .str="for" },
-	(keyw_map_t) { .keyw=TKN_RETURN,   .str="return" },
-	(keyw_map_t) { .keyw=TKN_ASM,      .str="asm" },
-	(keyw_map_t) { .keyw=TKN_GOTO,     .str="goto" },
-	(keyw_map_t) { .keyw=TKN_VOLATILE, .str="volatile" },
-	(keyw_map_t) { .keyw=TKN_INLINE,   .str="inline" },
-};
-static const size_t keyw_map_len = sizeof(keyw_map) / sizeof(keyw_map_t);
-
-// The error type returned by tokenise_int, if any.
-static error_type_t tkn_int_err_type;
-// The error message returned by tokenise_int, if any.
-static char        *tkn_int_err_msg;
-// Whether or not to free tkn_int_err_msg.
-static bool         tkn_int_err_do_free;
+// Classifies an identifier as a keyword.
+// Switches on length and first character, then confirms with a single compare.
+// Returns the keyword's token, or 0 if it is not a keyword.
+int tokeniser_keyword(const char *str, size_t len) {
+#define KEYW(keyw, tkn) (!memcmp(str, keyw, len) ? (tkn) : 0)
+	switch (len) {
+		case 2:
+			if (*str == 'i') return KEYW("if", TKN_IF);
+			break;
+		case 3:
+			switch (*str) {
+				case 'i': return KEYW("int",      TKN_INT);
+				case 'f': return KEYW("for",      TKN_FOR);
+				case 'a': return KEYW("asm",      TKN_ASM);
+			}
+			break;
+		case 4:
+			switch (*str) {
+				case 'v': return KEYW("void",     TKN_VOID);
+				case 'l': return KEYW("long",     TKN_LONG);
+				case 'c': return KEYW("char",     TKN_CHAR);
+				case 'b': return KEYW("bool",     TKN_BOOL);
+				case 'e': return KEYW("else",     TKN_ELSE);
+				case 'g': return KEYW("goto",     TKN_GOTO);
+			}
+			break;
+		case 5:
+			switch (*str) {
+				case 's': return KEYW("short",    TKN_SHORT);
+				case 'f': return KEYW("float",    TKN_FLOAT);
+				case 'w': return KEYW("while",    TKN_WHILE);
+			}
+			break;
+		case 6:
+			switch (*str) {
+				case 'd': return KEYW("double",   TKN_DOUBLE);
+				case 's': return KEYW("signed",   TKN_SIGNED);
+				case 'r': return KEYW("return",   TKN_RETURN);
+				case 'i': return KEYW("inline",   TKN_INLINE);
+			}
+			break;
+		case 8:
+			switch (*str) {
+				case 'u': return KEYW("unsigned", TKN_UNSIGNED);
+				case 'v': return KEYW("volatile", TKN_VOLATILE);
+			}
+			break;
+	}
+	return 0;
+#undef KEYW
+}
 
 // Grab next non-space token (internal method).
-static int tokenise_int(tokeniser_ctx_t *ctx, int *i0, int *x0, int *y0) {
+static int tokenise_int(tokeniser_ctx_t *ctx, YYSTYPE *lval, int *i0, int *x0, int *y0) {
 	// Get the first non-space character.
 	char c;
 	retry:
+	tokeniser_skip_space(ctx);
 	do {
 		c = tokeniser_readchar(ctx);
 	} while(is_space(c));
@@ -425,7 +737,9 @@ static int tokenise_int(tokeniser_ctx_t *ctx, int *i0, int *x0, int *y0) {
 			} else if (next == '/') {
 				// This starts a line commment.
 				linecomment:
-				for (long i = 1; c != '\r' && c != '\n'; i++) {
+				for (long i = 1; c && c != '\r' && c != '\n'; i++) {
+					// Skip to the first newline or backslash.
+					tokeniser_skip_until(ctx, '\r', '\n', '\\');
 					c = tokeniser_readchar(ctx);
 					char next = tokeniser_nextchar(ctx);
 					if (c == '\\' && (next == '\r' || next == '\n')) {
@@ -437,6 +751,10 @@ static int tokenise_int(tokeniser_ctx_t *ctx, int *i0, int *x0, int *y0) {
 			} else if (next == '*') {
 				// This starts a block commment.
 				for (long i = 1; c != 0; i++) {
+					// Skip to the next character that could end the comment.
+					if (c != '*' && tokeniser_skip_until(ctx, '\r', '*', 0)) {
+						c = tokeniser_raw_at(ctx, ctx->index - 1);
+					}
 					char q = tokeniser_readchar(ctx);
 					char next = tokeniser_nextchar(ctx);
 					if (c == '*' && q == '/') {
@@ -566,7 +884,7 @@ static int tokenise_int(tokeniser_ctx_t *ctx, int *i0, int *x0, int *y0) {
 		int ival = strtoull(strval, NULL, 16);
 		DEBUG_TKN("ival  %d (0x%s)\n", ival, strval);
 		xfree(ctx->allocator, strval);
-		yylval.ival.ival = ival;
+		lval->ival.ival = ival;
 		return TKN_IVAL;
 	}
 	
@@ -587,7 +905,7 @@ static int tokenise_int(tokeniser_ctx_t *ctx, int *i0, int *x0, int *y0) {
 		int ival = strtoull(strval, NULL, c == '0' ? 8 : 10);
 		DEBUG_TKN("ival  %d (%s)\n", ival, strval);
 		xfree(ctx->allocator, strval);
-		yylval.ival.ival = ival;
+		lval->ival.ival = ival;
 		return TKN_IVAL;
 	}
     
@@ -597,36 +915,39 @@ static int tokenise_int(tokeniser_ctx_t *ctx, int *i0, int *x0, int *y0) {
 		int offs = 0;
 		while (is_alphanumeric(tokeniser_nextchar_no(ctx, offs))) offs++;
 		offs ++;
-		// Now, grab it.
-		char *strval = (char *) xalloc(ctx->allocator, sizeof(char) * (offs + 1));
-		*strval = c;
-		strval[offs] = 0;
-		for (int i = 1; i < offs; i++) {
-			strval[i] = tokeniser_readchar(ctx);
-		}
-		// Next, check for keywords.
-		int keyw = 0;
-		for (int i = 0; i < keyw_map_len; i++) {
-			if (!strcmp(strval, keyw_map[i].str)) {
-				keyw = keyw_map[i].keyw;
-				break;
+		// Now, grab it; in memory it can be used in place.
+		char *strval;
+		if (ctx->use_fd) {
+			strval = (char *) xalloc(ctx->allocator, sizeof(char) * (offs + 1));
+			*strval = c;
+			strval[offs] = 0;
+			for (int i = 1; i < offs; i++) {
+				strval[i] = tokeniser_readchar(ctx);
+			}
+		} else {
+			strval = ctx->source + ctx->index - 1;
+			for (int i = 1; i < offs; i++) {
+				tokeniser_readchar(ctx);
 			}
 		}
+		// Next, check for keywords.
+		int keyw = tokeniser_keyword(strval, offs);
+		const char *ident = keyw ? NULL : intern_n(strval, offs);
+		if (ctx->use_fd) xfree(ctx->allocator, strval);
 		// Return the appropriate alternative.
 		if (keyw) {
-			DEBUG_TKN("token '%s'\n", strval);
-			xfree(ctx->allocator, strval);
+			DEBUG_TKN("token '%.*s'\n", offs, strval);
 			return keyw;
 		}
-		DEBUG_TKN("ident '%s'\n", strval);
-		yylval.ident.strval = strval;
+		DEBUG_TKN("ident '%s'\n", ident);
+		lval->ident.strval = (char *) ident;
 		return TKN_IDENT;
 	}
 	
 	// Or a string value.
 	if (c == '"') {
 		char *strval = tokeniser_getstr(ctx, '"');
-		yylval.strval.strval = strval;
+		lval->strval.strval = strval;
 		DEBUG_TKN("str   \"%s\"\n", strval);
 		return TKN_STRVAL;
 	}
@@ -638,14 +959,14 @@ static int tokenise_int(tokeniser_ctx_t *ctx, int *i0, int *x0, int *y0) {
 		
 		if (strlen(strval) > 1) {
 			// Warn if the constant is too long.
-			tkn_int_err_msg     = "Multi-character character constant.";
-			tkn_int_err_type    = E_WARN;
-			tkn_int_err_do_free = false;
+			ctx->err_msg     = "Multi-character character constant.";
+			ctx->err_type    = E_WARN;
+			ctx->err_do_free = false;
 		} else if (!*strval) {
 			// Error if the constant is empty.
-			tkn_int_err_msg     = "Empty character constant.";
-			tkn_int_err_type    = E_ERROR;
-			tkn_int_err_do_free = false;
+			ctx->err_msg     = "Empty character constant.";
+			ctx->err_type    = E_ERROR;
+			ctx->err_do_free = false;
 		}
 		
 		// Turn into an int.
@@ -653,7 +974,7 @@ static int tokenise_int(tokeniser_ctx_t *ctx, int *i0, int *x0, int *y0) {
 			ival = (ival << 8) | (unsigned char) *strval;
 			strval ++;
 		}
-		yylval.ival.ival = ival;
+		lval->ival.ival = ival;
 		DEBUG_TKN("char  '%c'\n", ival);
 		return TKN_IVAL;
 	}
@@ -664,21 +985,22 @@ static int tokenise_int(tokeniser_ctx_t *ctx, int *i0, int *x0, int *y0) {
 	garbagestr[0] = c;
 	garbagestr[1] = 0;
 	DEBUG_TKN("???   '%c'\n", c);
-	tkn_int_err_msg     = "Unrecognised token.";
-	tkn_int_err_type    = E_ERROR;
-	tkn_int_err_do_free = false;
+	ctx->err_msg     = "Unrecognised token.";
+	ctx->err_type    = E_ERROR;
+	ctx->err_do_free = false;
 	return TKN_GARBAGE;
 }
 
-// Grab next non-space token.
-int tokenise(tokeniser_ctx_t *ctx) {
+// Grab next non-space token from the source.
+// Diagnostics are deferred to the token buffer while pre-tokenising.
+static int tokenise_src(tokeniser_ctx_t *ctx, YYSTYPE *lval) {
 	// Clear error.
-	tkn_int_err_msg = NULL;
+	ctx->err_msg = NULL;
 	
 	// Pre-token position.
 	int i0, x0, y0;
 	// Get token data.
-	int tkn_id = tokenise_int(ctx, &i0, &x0, &y0);
+	int tkn_id = tokenise_int(ctx, lval, &i0, &x0, &y0);
 	if (!tkn_id) return 0;
 	// Post-token position.
 	int i1 = ctx->index;
@@ -686,7 +1008,7 @@ int tokenise(tokeniser_ctx_t *ctx) {
 	int y1 = ctx->y;
 	
 	// Return token after setting pos.
-	yylval.pos = (pos_t) {
+	lval->pos = (pos_t) {
 		.filename = ctx->filename,
 		.index0   = i0,
 		.index1   = i1+1,
@@ -695,15 +1017,182 @@ int tokenise(tokeniser_ctx_t *ctx) {
 		.x1       = x1+1,
 		.y1       = y1
 	};
-	if (tkn_int_err_msg) {
+	if (ctx->err_msg && ctx->buf) {
+		// Keep error messages until the token is parsed.
+		tokeniser_diag_t diag = {
+			.token   = ctx->buf->num,
+			.type    = ctx->err_type,
+			.message = ctx->err_msg,
+			.do_free = ctx->err_do_free,
+		};
+		array_len_cap_concat(ctx->allocator, tokeniser_diag_t, ctx->buf->diags, ctx->buf->diags_cap, ctx->buf->diags_len, diag);
+	} else if (ctx->err_msg) {
 		// Report error messages.
-		report_error(ctx, tkn_int_err_type, yylval.pos, tkn_int_err_msg);
+		report_error(ctx, ctx->err_type, lval->pos, ctx->err_msg);
 		// Free memory if required.
-		if (tkn_int_err_do_free) free(tkn_int_err_msg);
+		if (ctx->err_do_free) free(ctx->err_msg);
 	}
 	return tkn_id;
 }
 
+// Computes the position after reading the first n characters, as tokeniser_readchar would have.
+static void tokeniser_pos_at(tokeniser_ctx_t *ctx, size_t n, int *x, int *y) {
+	// Count the lines starting at or before n.
+	size_t lo = 0, hi = ctx->line_starts_len;
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+		if (ctx->line_starts[mid] <= n) lo = mid + 1;
+		else hi = mid;
+	}
+	*y = lo;
+	*x = n - ctx->line_starts[lo - 1];
+}
+
+// Reports diagnostics deferred for tokens up to and including tkn.
+static void tokeniser_buf_diags(tokeniser_ctx_t *ctx, size_t tkn, pos_t pos) {
+	tokeniser_buf_t *buf = ctx->buf;
+	while (buf->next_diag < buf->diags_len && buf->diags[buf->next_diag].token <= tkn) {
+		tokeniser_diag_t *diag = &buf->diags[buf->next_diag++];
+		report_error(ctx, diag->type, pos, diag->message);
+		if (diag->do_free) free(diag->message);
+	}
+}
+
+// Grab next token from the token buffer.
+static int tokenise_buf(tokeniser_ctx_t *ctx, YYSTYPE *lval) {
+	tokeniser_buf_t *buf = ctx->buf;
+	if (buf->next >= buf->num) {
+		// Leave the tokeniser at the end, as if it had read everything.
+		ctx->index = buf->end_index;
+		ctx->x     = buf->end_x;
+		ctx->y     = buf->end_y;
+		// Anything still pending belongs to the end of the source.
+		lval->pos = (pos_t) {
+			.filename = ctx->filename,
+			.index0   = buf->end_index,
+			.index1   = buf->end_index+1,
+			.x0       = buf->end_x,
+			.y0       = buf->end_y,
+			.x1       = buf->end_x+1,
+			.y1       = buf->end_y
+		};
+		tokeniser_buf_diags(ctx, SIZE_MAX, lval->pos);
+		return 0;
+	}
+	size_t tkn = buf->next++;
+	
+	// Recover the token's position.
+	size_t i0 = buf->offsets[tkn];
+	size_t i1 = i0 + buf->lengths[tkn];
+	int x0, y0, x1, y1;
+	tokeniser_pos_at(ctx, i0, &x0, &y0);
+	tokeniser_pos_at(ctx, i1, &x1, &y1);
+	// Leave the tokeniser where it would have been after reading this token.
+	ctx->index = i1;
+	ctx->x     = x1;
+	ctx->y     = y1;
+	
+	// Return token after setting pos and value.
+	lval->pos = (pos_t) {
+		.filename = ctx->filename,
+		.index0   = i0,
+		.index1   = i1+1,
+		.x0       = x0,
+		.y0       = y0,
+		.x1       = x1+1,
+		.y1       = y1
+	};
+	switch (buf->kinds[tkn]) {
+		case TKN_IVAL:
+			lval->ival.ival = buf->values[tkn];
+			break;
+		case TKN_IDENT:
+			lval->strval.strval = (char *) intern_get(buf->values[tkn]);
+			break;
+		case TKN_STRVAL:
+			lval->strval.strval = buf->strings[buf->values[tkn]];
+			break;
+	}
+	
+	// Report diagnostics deferred for this token.
+	tokeniser_buf_diags(ctx, tkn, lval->pos);
+	return buf->kinds[tkn];
+}
+
+// Tokenise the entire source into a compact buffer ahead of parsing.
+// Subsequent calls to tokenise are served from the buffer.
+void tokeniser_pretokenise(tokeniser_ctx_t *ctx) {
+	tokeniser_buf_t *buf = xalloc(ctx->allocator, sizeof(tokeniser_buf_t));
+	*buf = (tokeniser_buf_t) {
+		.kinds       = NULL,
+		.offsets     = NULL,
+		.lengths     = NULL,
+		.values      = NULL,
+		.num         = 0,
+		.cap         = 0,
+		.next        = 0,
+		.strings     = NULL,
+		.strings_len = 0,
+		.strings_cap = 0,
+		.diags       = NULL,
+		.diags_len   = 0,
+		.diags_cap   = 0,
+		.next_diag   = 0,
+	};
+	ctx->buf = buf;
+	tokeniser_mark_line(ctx, 1, 0);
+	
+	YYSTYPE val;
+	while (1) {
+		int tkn = tokenise_src(ctx, &val);
+		if (!tkn) break;
+		
+		// Make capacity.
+		if (buf->num >= buf->cap) {
+			buf->cap     = buf->cap ? buf->cap * 2 : 256;
+			buf->kinds   = xrealloc(ctx->allocator, buf->kinds,   sizeof(uint16_t) * buf->cap);
+			buf->offsets = xrealloc(ctx->allocator, buf->offsets, sizeof(size_t)   * buf->cap);
+			buf->lengths = xrealloc(ctx->allocator, buf->lengths, sizeof(uint32_t) * buf->cap);
+			buf->values  = xrealloc(ctx->allocator, buf->values,  sizeof(int32_t)  * buf->cap);
+		}
+		
+		// Store the token.
+		buf->kinds  [buf->num] = tkn;
+		buf->offsets[buf->num] = val.pos.index0;
+		buf->lengths[buf->num] = val.pos.index1 - 1 - val.pos.index0;
+		switch (tkn) {
+			case TKN_IVAL:
+				buf->values[buf->num] = val.ival.ival;
+				break;
+			case TKN_IDENT:
+				buf->values[buf->num] = intern_id(val.strval.strval);
+				break;
+			case TKN_STRVAL:
+				buf->values[buf->num] = buf->strings_len;
+				array_len_cap_concat(ctx->allocator, char *, buf->strings, buf->strings_cap, buf->strings_len, val.strval.strval);
+				break;
+			default:
+				buf->values[buf->num] = 0;
+				break;
+		}
+		buf->num ++;
+	}
+	
+	// Remember the end position for when the parser reaches it.
+	buf->end_index = ctx->index;
+	buf->end_x     = ctx->x;
+	buf->end_y     = ctx->y;
+}
+
+// Grab next non-space token, storing its value and position in lval.
+int tokenise(tokeniser_ctx_t *ctx, YYSTYPE *lval) {
+	if (ctx->buf) {
+		return tokenise_buf(ctx, lval);
+	} else {
+		return tokenise_src(ctx, lval);
+	}
+}
+
 static void print_src(tokeniser_ctx_t *ctx, FILE *outfile, int line, int x0, int x1, char *col, int *outX0, int *outX1) {
 	int dummy;
 	if (!outX0) outX0 = &dummy;
@@ -712,41 +1201,31 @@ static void print_src(tokeniser_ctx_t *ctx, FILE *outfile, int line, int x0, int
 	int tab_size = 4;
 	
 	if (ctx->use_fd) {
-		// File descriptor source.
-		// Save the stream position.
-		long pos = ftell(ctx->fd);
-		fseek(ctx->fd, 0, SEEK_SET);
-		
-		// Find the line.
-		line --;
-		while (line && !feof(ctx->fd)) {
-			char c = fgetc(ctx->fd);
-			if (c == '\r') {
-				char next = fgetc(ctx->fd);
-				if (next != '\n') fseek(ctx->fd, -1, SEEK_CUR);
-				line --;
-			} else if (c == '\n') {
-				line --;
-			}
+		// Streamed source.
+		// Find the line, which may have left the ring already.
+		size_t start;
+		if (!tokeniser_find_line(ctx, line, &start) || !tokeniser_in_ring(ctx, start)) {
+			fputs("\033[0m\n", outfile);
+			return;
 		}
 		
-		// Find the line's length.
-		long line_start = ftell(ctx->fd);
-		while (!feof(ctx->fd)) {
-			char c = fgetc(ctx->fd);
-			if (c == '\r' || c == '\n') {
-				fseek(ctx->fd, -1, SEEK_CUR);
-				break;
-			}
+		// Find the line's length, as far as the ring allows.
+		size_t end = start;
+		while (tokeniser_in_ring(ctx, end)) {
+			char c = ctx->ring[end & (ctx->ring_cap - 1)];
+			if (!c || c == '\r' || c == '\n') break;
+			end ++;
+		}
+		// Reading ahead for the end may have pushed the start out of the ring.
+		if (start + ctx->ring_cap < ctx->ring_end) {
+			fputs("\033[0m\n", outfile);
+			return;
 		}
-		long line_end = ftell(ctx->fd);
-		long line_len = line_end - line_start;
 		
 		// Print the line.
-		fseek(ctx->fd, line_start, SEEK_SET);
 		int printed_x = 0;
-		for (long i = 0; i < line_len; i++) {
-			char c = fgetc(ctx->fd);
+		for (long i = 0; i < end - start; i++) {
+			char c = ctx->ring[(start + i) & (ctx->ring_cap - 1)];
 			if (i == x0 - 1) {
 				fputs(col, outfile);
 				*outX0 = printed_x + 1;
@@ -770,34 +1249,21 @@ static void print_src(tokeniser_ctx_t *ctx, FILE *outfile, int line, int x0, int
 				*outX1 = printed_x + 1;
 			}
 		}
-		
-		// Reset the stream position.
-		fseek(ctx->fd, pos, SEEK_SET);
 	} else {
-		// C-string source.
+		// In-memory source.
 		// Find the line.
-		char *index = ctx->source;
-		line --;
-		for (size_t i = 0; i < ctx->source_len && line; i++) {
-			char *ptr = &ctx->source[i];
-			if (*ptr == '\r') {
-				if (ptr[1] == '\n') index = ptr + 2;
-				else index = ptr + 1;
-				line --;
-			} else if (*ptr == '\n') {
-				index = ptr + 1;
-				line --;
-			}
+		size_t start;
+		if (!tokeniser_find_line(ctx, line, &start)) {
+			fputs("\033[0m\n", outfile);
+			return;
 		}
+		char *index = ctx->source + start;
+		char *end   = ctx->source + ctx->source_len;
 		
 		// Find line's length.
-		char *a = strchr(index, '\r');
-		char *b = strchr(index, '\n');
-		if (b < a || !a && b) {
-			a = b;
-		} else if (!a) {
-			a = index + strlen(index);
-		}
+		// The source need not be NUL-terminated if it is mapped.
+		char *a = index;
+		while (a < end && *a && *a != '\r' && *a != '\n') a++;
 		
 		// Print the line.
 		int printed_x = 0;
@@ -807,16 +1273,16 @@ static void print_src(tokeniser_ctx_t *ctx, FILE *outfile, int line, int x0, int
 				fputs(col, outfile);
 				*outX0 = printed_x + 1;
 			}
-			if (c < 0x20 || c >= 0x7f) {
-				fputc(' ', outfile);
-				printed_x ++;
-			} else if (c == '\t') {
+			if (c == '\t') {
 				int error = printed_x % tab_size;
 				while (error < tab_size) {
 					fputc(' ', outfile);
 					error ++;
 					printed_x ++;
 				}
+			} else if (c < 0x20 || c >= 0x7f) {
+				fputc(' ', outfile);
+				printed_x ++;
 			} else {
 				fputc(c, outfile);
 				printed_x ++;
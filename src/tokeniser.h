@@ -3,9 +3,12 @@
 #define TOKENISER_H
 
 struct tokeniser_ctx;
+struct tokeniser_buf;
 struct pos;
+union YYSTYPE;
 
 typedef struct tokeniser_ctx tokeniser_ctx_t;
+typedef struct tokeniser_buf tokeniser_buf_t;
 typedef struct pos pos_t;
 
 typedef enum {
@@ -33,19 +36,92 @@ struct pos {
 struct tokeniser_ctx {
 	// Filename.
 	char      *filename;
-	// For raw string inputs.
+	// For raw string inputs, also used for file inputs read into memory.
 	char       *source;
 	size_t      source_len;
-	// For file descriptor inputs.
+	// Whether source is a memory mapping of the file (as opposed to a copy).
+	bool        is_mapped;
+	// For file descriptor inputs that can't be mapped, like pipes.
 	FILE       *fd;
 	bool        use_fd;
+	// Ring buffer holding the last ring_cap characters read from fd.
+	// Character i lives at ring[i & (ring_cap - 1)].
+	char       *ring;
+	size_t      ring_cap;
+	// Index just past the last character read into the ring.
+	size_t      ring_end;
+	// Whether fd has no more to give.
+	bool        ring_eof;
 	// Current position.
 	size_t      index;
 	int         x, y;
+	// Start index of every line seen so far, line 1 is at index 0.
+	// Filled by tokeniser_readchar and extended on demand for diagnostics.
+	size_t     *line_starts;
+	size_t      line_starts_len;
+	size_t      line_starts_cap;
+	// Number of lines dropped from the start of line_starts.
+	// Streamed sources forget lines that have left the ring buffer.
+	size_t      line_starts_dropped;
+	// Tokens lexed ahead of parsing, if tokeniser_pretokenise was used.
+	tokeniser_buf_t *buf;
+	// The error type raised by the last token, if any.
+	error_type_t err_type;
+	// The error message raised by the last token, if any.
+	char        *err_msg;
+	// Whether or not to free err_msg.
+	bool         err_do_free;
 	// Allocation context to use for e.g. strings.
 	alloc_ctx_t allocator;
 };
 
+// A diagnostic raised while pre-tokenising, reported when its token is parsed.
+typedef struct {
+	// Index of the token that raised it.
+	size_t       token;
+	// Severity of the diagnostic.
+	error_type_t type;
+	// Message to report.
+	char        *message;
+	// Whether or not to free message after reporting.
+	bool         do_free;
+} tokeniser_diag_t;
+
+// A whole source's worth of tokens, stored as a structure of arrays.
+// Positions are not stored, but recovered from the line start table.
+struct tokeniser_buf {
+	// Token kinds as returned by tokenise.
+	uint16_t         *kinds;
+	// Index of each token's first character.
+	size_t           *offsets;
+	// Length of each token in characters.
+	uint32_t         *lengths;
+	// The integer for TKN_IVAL, interned id for TKN_IDENT, index into strings for TKN_STRVAL.
+	int32_t          *values;
+	// Number of tokens stored.
+	size_t            num;
+	// Capacity of the token arrays.
+	size_t            cap;
+	// Next token to hand to the parser.
+	size_t            next;
+	
+	// Values of TKN_STRVAL tokens.
+	char            **strings;
+	size_t            strings_len;
+	size_t            strings_cap;
+	
+	// Diagnostics raised while pre-tokenising, in token order.
+	tokeniser_diag_t *diags;
+	size_t            diags_len;
+	size_t            diags_cap;
+	// Next diagnostic to report.
+	size_t            next_diag;
+	
+	// Position at the end of the source.
+	size_t            end_index;
+	int               end_x, end_y;
+};
+
 #include <parser-util.h>
 
 pos_t pos_merge(pos_t one, pos_t two);
@@ -66,6 +142,7 @@ void print_line(tokeniser_ctx_t *ctx, int lineno);
 // Initialise a context, given c-string.
 void tokeniser_init_cstr(tokeniser_ctx_t *ctx, char *raw);
 // Initialise a context, given a file descriptor.
+// Maps the file into memory, or streams it if mapping is not possible.
 void tokeniser_init_file(tokeniser_ctx_t *ctx, FILE *file);
 // Clean up a tokeniser context.
 void tokeniser_destroy(tokeniser_ctx_t *ctx);
@@ -90,7 +167,15 @@ char tokeniser_nextchar_no(tokeniser_ctx_t *ctx, int no);
 // Unescape an escaped c-string.
 char *tokeniser_getstr(tokeniser_ctx_t *ctx, char term);
 
-// Grab next non-space token.
-int tokenise(tokeniser_ctx_t *ctx);
+// Classifies an identifier as a keyword.
+// Returns the keyword's token, or 0 if it is not a keyword.
+int tokeniser_keyword(const char *str, size_t len);
+
+// Tokenise the entire source into a compact buffer ahead of parsing.
+// Subsequent calls to tokenise are served from the buffer.
+void tokeniser_pretokenise(tokeniser_ctx_t *ctx);
+
+// Grab next non-space token, storing its value and position in lval.
+int tokenise(tokeniser_ctx_t *ctx, union YYSTYPE *lval);
 
 #endif // TOKENISER_H
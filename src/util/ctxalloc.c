@@ -9,9 +9,32 @@
 #define ALLOC_BIT_MAGIC2 0x4839678fcf3d0596LLU
 #define ALLOC_CTX_MAGIC1 0x9cc1c4fd0e25a9d8LLU
 #define ALLOC_CTX_MAGIC2 0x40ec817d60963a2dLLU
+#define ALLOC_ARENA_MAGIC 0x2f7a1c93b8d4e605LLU
+// Set in the capacity of arena allocations, whose header always ends in an odd word.
+#define ALLOC_ARENA_FLAG  1
+// Byte written over freed memory in checked builds.
+#define ALLOC_POISON      0xa5
+
+// Size of the first block of an arena.
+#define ALLOC_ARENA_MIN_BLOCK 4096
+// Maximum size of later blocks of an arena.
+#define ALLOC_ARENA_MAX_BLOCK 65536
+// Allocations larger than this are not carved out of arena blocks.
+#define ALLOC_ARENA_MAX_SIZE  1024
+// Allocations up to this size are recycled through size class free lists.
+#define ALLOC_POOL_MAX_SIZE   (ALLOC_POOL_CLASSES * 8)
+// Number of block sizes in the per-thread block cache, doubling from ALLOC_ARENA_MIN_BLOCK.
+#define ALLOC_CACHE_SIZES     5
+// Number of blocks of each size kept in the per-thread block cache.
+#define ALLOC_CACHE_DEPTH     8
 
 alloc_ctx_t global_alloc = NULL;
 
+// Re-allocation counters, always recorded.
+static xrealloc_stats_t alloc_realloc_counts;
+
+#ifdef ALLOC_CHECKED
+
 // Checks the magic values for a alloc bit.
 static inline bool alloc_bit_magic_check(alloc_bit_t *bit) {
 	return bit->magic1 == ALLOC_BIT_MAGIC1 && bit->magic2 == ALLOC_BIT_MAGIC2;
@@ -55,8 +78,8 @@ static bool alloc_is_child(alloc_ctx_t parent, alloc_ctx_t child) {
 
 #if 0
 #define ALLOC_BIT_OWNER_ASSERT(bit, ctx) do {\
-		alloc_bit_t *p = (bit);\
-		alloc_ctx_t  q = (ctx);\
+		__typeof__(bit) p = (bit);\
+		alloc_ctx_t     q = (ctx);\
 		if (!alloc_is_child(p->owner, q)) {\
 			fflush(stdout);\
 			fprintf(stderr, "\033[1m%s:%d: \033[91mfatal error:\033[0m Allocated memory does not belong to given context (%p to %p)\n", __FILE__, __LINE__, p, q);\
@@ -67,8 +90,8 @@ static bool alloc_is_child(alloc_ctx_t parent, alloc_ctx_t child) {
 	} while(0)
 #else
 #define ALLOC_BIT_OWNER_ASSERT(bit, ctx) do {\
-		alloc_bit_t *p = (bit);\
-		alloc_ctx_t  q = (ctx);\
+		__typeof__(bit) p = (bit);\
+		alloc_ctx_t     q = (ctx);\
 		if (!alloc_is_child(p->owner, q)) {\
 			fflush(stdout);\
 			fprintf(stderr, "\033[1m%s:%d: \033[33mwarning:\033[0m Allocated memory does not belong to given context (%p to %p)\n", __FILE__, __LINE__, p, q);\
@@ -77,15 +100,411 @@ static bool alloc_is_child(alloc_ctx_t parent, alloc_ctx_t child) {
 	} while(0)
 #endif
 
+// Poisons memory about to be freed, to catch use after free.
+#define ALLOC_POISON_MEMORY(memory, size) memset(memory, ALLOC_POISON, size)
+
+// Asserts that pooled memory was not written to since it was freed.
+// The first word is used by the free list.
+#define ALLOC_POISON_ASSERT(memory, size) do {\
+		uint8_t *p = (memory);\
+		for (size_t i = sizeof(void *); i < (size); i++) {\
+			if (p[i] != ALLOC_POISON) {\
+				fflush(stdout);\
+				fprintf(stderr, "\033[1m%s:%d: \033[91mfatal error:\033[0m Freed memory was written to (%p)\n", __FILE__, __LINE__, p);\
+				fprintf(stderr, "\033[1;91mAborting!\n");\
+				fflush(stderr);\
+				abort();\
+			}\
+		}\
+	} while(0)
+
+#else //ALLOC_CHECKED
+
+// Release builds trust the caller.
+#define ALLOC_BIT_MAGIC_ASSERT(bit)       do {} while(0)
+#define ALLOC_CTX_MAGIC_ASSERT(ctx)       do {} while(0)
+#define ALLOC_BIT_OWNER_ASSERT(bit, ctx)  do {} while(0)
+#define ALLOC_POISON_MEMORY(memory, size) do {} while(0)
+#define ALLOC_POISON_ASSERT(memory, size) do {} while(0)
+
+#endif //ALLOC_CHECKED
+
+
+// Tests whether memory was carved out of an arena.
+// The header of an arena allocation ends in an odd word, that of other memory in a pointer or magic value.
+static inline bool alloc_is_arena_bit(void *memory) {
+#ifdef ALLOC_CHECKED
+	return ((uint64_t *) memory)[-1] == ALLOC_ARENA_MAGIC;
+#else
+	return ((uint64_t *) memory)[-1] & ALLOC_ARENA_FLAG;
+#endif
+}
+
+// Gets the usable size of an arena allocation.
+static inline size_t alloc_arena_cap(alloc_arena_bit_t *bit) {
+	return bit->cap & ~(size_t) ALLOC_ARENA_FLAG;
+}
+
+// Arena blocks freed by this thread, kept for reuse by size.
+static __thread alloc_block_t *alloc_block_cache [ALLOC_CACHE_SIZES];
+static __thread size_t         alloc_block_cached[ALLOC_CACHE_SIZES];
+
+// Gets the index in the block cache for blocks of a size.
+static inline size_t alloc_block_cache_index(size_t cap) {
+	size_t i = 0;
+	while ((ALLOC_ARENA_MIN_BLOCK << i) < cap) i++;
+	return i;
+}
+
+// Gets an arena block from the thread's cache, or a new one.
+static alloc_block_t *alloc_block_take(size_t cap) {
+	size_t i = alloc_block_cache_index(cap);
+	alloc_block_t *block = alloc_block_cache[i];
+	if (block) {
+		alloc_block_cache[i] = block->next;
+		alloc_block_cached[i] --;
+		return block;
+	}
+	block = malloc(sizeof(alloc_block_t) + cap);
+	if (block) block->cap = cap;
+	return block;
+}
+
+// Returns an arena block to the thread's cache, or frees it if the cache is full.
+static void alloc_block_give(alloc_block_t *block) {
+	size_t i = alloc_block_cache_index(block->cap);
+	ALLOC_POISON_MEMORY(block + 1, block->cap);
+	if (alloc_block_cached[i] < ALLOC_CACHE_DEPTH) {
+		block->next = alloc_block_cache[i];
+		alloc_block_cache[i] = block;
+		alloc_block_cached[i] ++;
+	} else {
+		free(block);
+	}
+}
+
+// Frees the arena blocks cached by the calling thread; call before an allocating thread exits.
+void alloc_thread_cleanup() {
+	for (size_t i = 0; i < ALLOC_CACHE_SIZES; i++) {
+		while (alloc_block_cache[i]) {
+			alloc_block_t *block = alloc_block_cache[i];
+			alloc_block_cache[i] = block->next;
+			free(block);
+		}
+		alloc_block_cached[i] = 0;
+	}
+}
+
+// Carves memory out of the most recent arena block, adding a block if it does not fit.
+static void *alloc_arena_carve(alloc_ctx_t ctx, size_t size) {
+	// Keep allocations 8-byte aligned, like those of the regular allocator.
+	size_t cap    = size ? (size + 7) & ~(size_t) 7 : 8;
+	size_t needed = sizeof(alloc_arena_bit_t) + cap;
+	
+	// Recycle memory of the same size class if there is any.
+	if (cap <= ALLOC_POOL_MAX_SIZE && ctx->pools[cap / 8 - 1]) {
+		void *mem = ctx->pools[cap / 8 - 1];
+		ALLOC_POISON_ASSERT(mem, cap);
+		ctx->pools[cap / 8 - 1] = *(void **) mem;
+#ifdef ALLOC_CHECKED
+		((alloc_arena_bit_t *) mem - 1)->magic = ALLOC_ARENA_MAGIC;
+#endif
+		return mem;
+	}
+	
+	alloc_block_t *block = ctx->blocks;
+	if (!block || block->cap - block->used < needed) {
+		// Each block is twice the size of the previous, up to a limit.
+		size_t block_cap = block ? block->cap * 2 : ALLOC_ARENA_MIN_BLOCK;
+		if (block_cap > ALLOC_ARENA_MAX_BLOCK) block_cap = ALLOC_ARENA_MAX_BLOCK;
+		block = alloc_block_take(block_cap);
+		if (!block) return NULL;
+		block->next = ctx->blocks;
+		block->used = 0;
+		ctx->blocks = block;
+	}
+	
+	// Insert the header.
+	alloc_arena_bit_t *bit = (alloc_arena_bit_t *) ((size_t) (block + 1) + block->used);
+	*bit = (alloc_arena_bit_t) {
+		.owner = ctx,
+		.cap   = cap | ALLOC_ARENA_FLAG,
+#ifdef ALLOC_CHECKED
+		.magic = ALLOC_ARENA_MAGIC,
+#endif
+	};
+	block->used += needed;
+	
+	return bit + 1;
+}
+
+
+
+/* ======== Statistics ======== */
+
+// Number of size buckets in the histograms, powers of two from 8 bytes.
+#define ALLOC_HIST_BUCKETS 12
+// Number of allocation sites listed in the report.
+#define ALLOC_REPORT_SITES 20
+
+// Statistics about all contexts created at one place.
+struct alloc_ctx_stats {
+	const char *file;
+	int         line;
+	// Number of contexts created here.
+	size_t      contexts;
+	// Number of allocations made on these contexts.
+	size_t      allocs;
+	// Bytes currently allocated on these contexts, and the most there have been.
+	size_t      live, peak;
+	// Number of allocations by size.
+	size_t      hist[ALLOC_HIST_BUCKETS];
+};
+
+// Statistics about allocations made at one place.
+typedef struct {
+	const char *file;
+	int         line;
+	size_t      allocs;
+	size_t      bytes;
+} alloc_site_stats_t;
+
+// A hash table of statistics, keyed by file and line.
+typedef struct {
+	void  **recs;
+	size_t  len;
+	size_t  cap;
+} alloc_stats_table_t;
+
+static bool                alloc_stats_on = false;
+static pthread_mutex_t     alloc_stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static alloc_stats_table_t alloc_ctx_table;
+static alloc_stats_table_t alloc_site_table;
+
+// Runs statistics code if enabled, under the statistics lock.
+#define ALLOC_STATS(code) do {\
+		if (alloc_stats_on) {\
+			pthread_mutex_lock(&alloc_stats_lock);\
+			code;\
+			pthread_mutex_unlock(&alloc_stats_lock);\
+		}\
+	} while(0)
+
+// Finds or adds the statistics record for a file and line.
+// Every record type starts with the file and line.
+static void *alloc_stats_lookup(alloc_stats_table_t *table, const char *file, int line, size_t rec_size) {
+	if (!file) file = "<unknown>";
+	
+	// Keep the table at most half full.
+	if (table->len * 2 >= table->cap) {
+		size_t  old_cap  = table->cap;
+		void  **old_recs = table->recs;
+		table->cap  = old_cap ? old_cap * 2 : 256;
+		table->recs = calloc(table->cap, sizeof(void *));
+		table->len  = 0;
+		for (size_t i = 0; i < old_cap; i++) {
+			if (!old_recs[i]) continue;
+			alloc_site_stats_t *rec = old_recs[i];
+			size_t j = (rec->line * 31 + strlen(rec->file)) & (table->cap - 1);
+			while (table->recs[j]) j = (j + 1) & (table->cap - 1);
+			table->recs[j] = rec;
+			table->len ++;
+		}
+		free(old_recs);
+	}
+	
+	// The same file name can be a different pointer in another translation unit.
+	size_t j = (line * 31 + strlen(file)) & (table->cap - 1);
+	while (table->recs[j]) {
+		alloc_site_stats_t *rec = table->recs[j];
+		if (rec->line == line && (rec->file == file || !strcmp(rec->file, file))) return rec;
+		j = (j + 1) & (table->cap - 1);
+	}
+	
+	alloc_site_stats_t *rec = calloc(1, rec_size);
+	rec->file = file;
+	rec->line = line;
+	table->recs[j] = rec;
+	table->len ++;
+	return rec;
+}
+
+// Gets the statistics record for a context.
+static alloc_ctx_stats_t *alloc_ctx_stats(alloc_ctx_t ctx) {
+	if (!ctx->stats) {
+		ctx->stats = alloc_stats_lookup(&alloc_ctx_table, ctx->file, ctx->line, sizeof(alloc_ctx_stats_t));
+		ctx->stats->contexts ++;
+	}
+	return ctx->stats;
+}
+
+// Gets the number of bytes usable in some allocated memory.
+static size_t alloc_usable_size(void *memory) {
+	if (alloc_is_arena_bit(memory)) {
+		return alloc_arena_cap((alloc_arena_bit_t *) memory - 1);
+	} else {
+		return malloc_usable_size((alloc_bit_t *) memory - 1) - sizeof(alloc_bit_t);
+	}
+}
+
+// Counts memory freed from a context.
+static void alloc_stats_sub(alloc_ctx_t ctx, size_t bytes) {
+	alloc_ctx_stats_t *stats = alloc_ctx_stats(ctx);
+	// Memory allocated before statistics were enabled was not counted.
+	if (bytes > ctx->live) bytes = ctx->live;
+	stats->live -= bytes;
+	ctx->live   -= bytes;
+}
+
+// Counts memory of a context that changed size.
+static void alloc_stats_resize(alloc_ctx_t ctx, size_t old_bytes, void *memory) {
+	alloc_stats_sub(ctx, old_bytes);
+	alloc_ctx_stats_t *stats = ctx->stats;
+	size_t bytes = alloc_usable_size(memory);
+	stats->live += bytes;
+	ctx->live   += bytes;
+	if (stats->live > stats->peak) stats->peak = stats->live;
+}
+
+// Counts memory allocated on a context.
+static void alloc_stats_add(alloc_ctx_t ctx, void *memory, size_t size) {
+	alloc_stats_resize(ctx, 0, memory);
+	size_t bucket = 0;
+	while (bucket < ALLOC_HIST_BUCKETS - 1 && size > (8LLU << bucket)) bucket ++;
+	ctx->stats->hist[bucket] ++;
+	ctx->stats->allocs ++;
+}
+
+// Counts an allocation made at some place.
+static void alloc_stats_site(const char *file, int line, size_t size) {
+	alloc_site_stats_t *site = alloc_stats_lookup(&alloc_site_table, file, line, sizeof(alloc_site_stats_t));
+	site->allocs ++;
+	site->bytes  += size;
+}
+
+// Sorts context statistics by peak size, largest first.
+static int alloc_ctx_stats_cmp(const void *a, const void *b) {
+	const alloc_ctx_stats_t *x = *(void **) a, *y = *(void **) b;
+	return (x->peak < y->peak) - (x->peak > y->peak);
+}
+
+// Sorts site statistics by bytes allocated, largest first.
+static int alloc_site_stats_cmp(const void *a, const void *b) {
+	const alloc_site_stats_t *x = *(void **) a, *y = *(void **) b;
+	return (x->bytes < y->bytes) - (x->bytes > y->bytes);
+}
+
+// Collects the records of a table into a sorted array.
+static size_t alloc_stats_sorted(alloc_stats_table_t *table, void ***out, int (*cmp)(const void *, const void *)) {
+	void **recs = malloc(sizeof(void *) * (table->len + 1));
+	size_t n = 0;
+	for (size_t i = 0; i < table->cap; i++) {
+		if (table->recs[i]) recs[n++] = table->recs[i];
+	}
+	qsort(recs, n, sizeof(void *), cmp);
+	*out = recs;
+	return n;
+}
+
+// Starts recording allocation statistics.
+void alloc_stats_enable() {
+	alloc_stats_on = true;
+}
+
+// Prints the contexts and allocation sites that used the most memory.
+void alloc_stats_report(FILE *fd) {
+	pthread_mutex_lock(&alloc_stats_lock);
+	void **recs;
+	size_t n = alloc_stats_sorted(&alloc_ctx_table, &recs, alloc_ctx_stats_cmp);
+	fprintf(fd, "Allocation contexts by peak size:\n");
+	fprintf(fd, "  %12s %12s %10s %8s  %s\n", "peak", "live", "allocs", "contexts", "created at");
+	for (size_t i = 0; i < n; i++) {
+		alloc_ctx_stats_t *stats = recs[i];
+		fprintf(fd, "  %12zu %12zu %10zu %8zu  ", stats->peak, stats->live, stats->allocs, stats->contexts);
+		if (stats->line) fprintf(fd, "%s:%d\n", stats->file, stats->line);
+		else fprintf(fd, "%s\n", stats->file);
+		// Histogram of allocation sizes.
+		fprintf(fd, "  %12s", "sizes");
+		for (size_t x = 0; x < ALLOC_HIST_BUCKETS; x++) {
+			if (!stats->hist[x]) continue;
+			if (x == ALLOC_HIST_BUCKETS - 1) fprintf(fd, " >%llu:%zu", 8LLU << (x - 1), stats->hist[x]);
+			else fprintf(fd, " <=%llu:%zu", 8LLU << x, stats->hist[x]);
+		}
+		fputc('\n', fd);
+	}
+	free(recs);
+	
+	n = alloc_stats_sorted(&alloc_site_table, &recs, alloc_site_stats_cmp);
+	fprintf(fd, "Top allocation sites by bytes allocated:\n");
+	fprintf(fd, "  %12s %10s  %s\n", "bytes", "allocs", "site");
+	for (size_t i = 0; i < n && i < ALLOC_REPORT_SITES; i++) {
+		alloc_site_stats_t *site = recs[i];
+		fprintf(fd, "  %12zu %10zu  %s:%d\n", site->bytes, site->allocs, site->file, site->line);
+	}
+	free(recs);
+	
+	xrealloc_stats_t re = xrealloc_stats();
+	fprintf(fd, "Re-allocations: %zu, %zu in place, %zu bytes copied\n", re.reallocs, re.in_place, re.copied);
+	pthread_mutex_unlock(&alloc_stats_lock);
+}
+
+
+// Gets the re-allocation counters since startup.
+xrealloc_stats_t xrealloc_stats() {
+	return (xrealloc_stats_t) {
+		.reallocs = __atomic_load_n(&alloc_realloc_counts.reallocs, __ATOMIC_RELAXED),
+		.in_place = __atomic_load_n(&alloc_realloc_counts.in_place, __ATOMIC_RELAXED),
+		.copied   = __atomic_load_n(&alloc_realloc_counts.copied, __ATOMIC_RELAXED),
+	};
+}
+
+
 
 // Initialises the alloc system thingy.
 void alloc_init() {
-	if (!global_alloc) global_alloc = alloc_create(ALLOC_NO_PARENT);
+	if (!global_alloc) {
+		global_alloc = alloc_create_at(ALLOC_NO_PARENT, false, "global_alloc", 0);
+		global_alloc->shared = true;
+		pthread_mutex_init(&global_alloc->lock, NULL);
+	}
+}
+
+// Hands a context over to its parent, which destroys it when cleared.
+// Memory on the context stays valid; safe to call concurrently for contexts with the same parent.
+void alloc_handoff(alloc_ctx_t ctx) {
+	// Assert the context is valid.
+	ALLOC_CTX_MAGIC_ASSERT(ctx);
+	if (ctx->parent) alloc_handoff_to(ctx->parent, ctx);
+}
+
+// Hands a context over to another context, which destroys it when cleared.
+// Memory on the context stays valid; safe to call concurrently for the same parent.
+void alloc_handoff_to(alloc_ctx_t parent, alloc_ctx_t ctx) {
+	// Assert the contexts are valid.
+	ALLOC_CTX_MAGIC_ASSERT(parent);
+	ALLOC_CTX_MAGIC_ASSERT(ctx);
+	
+	// Push onto the parent's list of adopted contexts.
+	alloc_ctx_t head = __atomic_load_n(&parent->adopted, __ATOMIC_RELAXED);
+	do {
+		ctx->next_adopted = head;
+	} while (!__atomic_compare_exchange_n(&parent->adopted, &head, ctx, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
 }
 
 
 // Creates a new memory allocation context.
 alloc_ctx_t alloc_create(alloc_ctx_t parent) {
+	return alloc_create_at(parent, false, NULL, 0);
+}
+
+// Creates a new memory allocation context which carves small allocations out of large blocks.
+// Freed allocations of up to 256 bytes are pooled for reuse, the rest is reclaimed when the context is cleared.
+alloc_ctx_t alloc_create_arena(alloc_ctx_t parent) {
+	return alloc_create_at(parent, true, NULL, 0);
+}
+
+// Creates a new memory allocation context, recording the call site for statistics.
+alloc_ctx_t alloc_create_at(alloc_ctx_t parent, bool arena, const char *file, int line) {
 	// Assert the parent is valid.
 	if (parent) ALLOC_CTX_MAGIC_ASSERT(parent);
 	else parent = global_alloc;
@@ -93,30 +512,71 @@ alloc_ctx_t alloc_create(alloc_ctx_t parent) {
 	// Create a new struct.
 	alloc_ctx_t ctx = malloc(sizeof(alloc_ctx_s));
 	*ctx = (alloc_ctx_s) {
+#ifdef ALLOC_CHECKED
 		.magic1 = ALLOC_CTX_MAGIC1,
+#endif
 		.parent = parent,
 		.first  = NULL,
+		.last   = NULL,
+		.blocks = NULL,
+		.pools  = {NULL},
+		.arena  = arena,
+		.file   = file,
+		.line   = line,
+		.stats  = NULL,
+		.live   = 0,
+		.adopted      = NULL,
+		.next_adopted = NULL,
+		.shared = false,
+#ifdef ALLOC_CHECKED
 		.magic2 = ALLOC_CTX_MAGIC2,
+#endif
 	};
+	ALLOC_STATS(alloc_ctx_stats(ctx));
 	return ctx;
 }
 
-// Frees all memory of the context, recursively.
-void alloc_clear(alloc_ctx_t ctx) {
-	// Assert the context is valid.
-	ALLOC_CTX_MAGIC_ASSERT(ctx);
+// Frees all memory of the context, recursively, without locking.
+static void ctx_clear(alloc_ctx_t ctx) {
+	// Contexts handed off to this one go first.
+	alloc_ctx_t child = __atomic_exchange_n(&ctx->adopted, NULL, __ATOMIC_ACQUIRE);
+	while (child) {
+		alloc_ctx_t next = child->next_adopted;
+		alloc_destroy(child);
+		child = next;
+	}
+	
+	ALLOC_STATS(alloc_stats_sub(ctx, ctx->live));
 	
 	// Iterate over ALL the things.
 	alloc_bit_t *bit = ctx->first;
 	while (bit) {
 		void *mem = bit;
-		bit->magic1 = 0;
-		bit->magic2 = 0;
 		bit = bit->next;
+		ALLOC_POISON_MEMORY(mem, malloc_usable_size(mem));
 		free(mem);
 	}
 	ctx->first = NULL;
 	ctx->last  = NULL;
+	
+	// Arena blocks go all at once.
+	alloc_block_t *block = ctx->blocks;
+	while (block) {
+		alloc_block_t *next = block->next;
+		alloc_block_give(block);
+		block = next;
+	}
+	ctx->blocks = NULL;
+	memset(ctx->pools, 0, sizeof(ctx->pools));
+}
+
+// Frees all memory of the context, recursively.
+void alloc_clear(alloc_ctx_t ctx) {
+	// Assert the context is valid.
+	ALLOC_CTX_MAGIC_ASSERT(ctx);
+	if (ctx->shared) pthread_mutex_lock(&ctx->lock);
+	ctx_clear(ctx);
+	if (ctx->shared) pthread_mutex_unlock(&ctx->lock);
 }
 
 // Frees all memory of the context and destroys the context.
@@ -125,17 +585,34 @@ void alloc_destroy(alloc_ctx_t ctx) {
 	ALLOC_CTX_MAGIC_ASSERT(ctx);
 	// Clear out the context.
 	alloc_clear(ctx);
+#ifdef ALLOC_CHECKED
 	ctx->magic1 = 0;
 	ctx->magic2 = 0;
+#endif
+	if (ctx->shared) pthread_mutex_destroy(&ctx->lock);
 	// Free the memory.
 	free(ctx);
 }
 
 
-// Allocates memory belonging to a context.
-void *alloc_on_ctx(alloc_ctx_t ctx, size_t size) {
-	// Assert the context is valid.
-	ALLOC_CTX_MAGIC_ASSERT(ctx);
+static void ctx_free(alloc_ctx_t ctx, void *memory);
+
+// Gets the context that owns memory, or ctx itself for NULL.
+// The owner never changes, so this is safe without locking.
+static inline alloc_ctx_t alloc_owner_of(alloc_ctx_t ctx, void *memory) {
+	if (!memory) return ctx;
+	if (alloc_is_arena_bit(memory)) return ((alloc_arena_bit_t *) memory - 1)->owner;
+	return ((alloc_bit_t *) memory - 1)->owner;
+}
+
+// Allocates memory belonging to a context, without locking.
+static void *ctx_alloc(alloc_ctx_t ctx, size_t size) {
+	// Small allocations in an arena don't get their own malloc.
+	if (ctx->arena && size <= ALLOC_ARENA_MAX_SIZE) {
+		void *ptr = alloc_arena_carve(ctx, size);
+		if (ptr) ALLOC_STATS(alloc_stats_add(ctx, ptr, size));
+		return ptr;
+	}
 	
 	// Try to get some memory, yes?
 	void *newmem = malloc(sizeof(alloc_bit_t) + size);
@@ -145,9 +622,11 @@ void *alloc_on_ctx(alloc_ctx_t ctx, size_t size) {
 	alloc_bit_t *bit = newmem;
 	void        *ptr = (void *) ((size_t) newmem + sizeof(alloc_bit_t));
 	*bit = (alloc_bit_t) {
+#ifdef ALLOC_CHECKED
 		.magic1 = ALLOC_BIT_MAGIC1,
-		.owner  = ctx,
 		.magic2 = ALLOC_BIT_MAGIC2,
+#endif
+		.owner  = ctx,
 	};
 	
 	// Set up next and prev pointers.
@@ -164,21 +643,67 @@ void *alloc_on_ctx(alloc_ctx_t ctx, size_t size) {
 	ctx->last       = bit;
 	
 	// Return the allocated memory.
+	ALLOC_STATS(alloc_stats_add(ctx, ptr, size));
 	return ptr;
 }
 
-// Re-allocates memory belonging to a context.
-void *realloc_on_ctx(alloc_ctx_t ctx, void *memory, size_t size) {
+// Allocates memory belonging to a context.
+void *alloc_on_ctx(alloc_ctx_t ctx, size_t size) {
 	// Assert the context is valid.
 	ALLOC_CTX_MAGIC_ASSERT(ctx);
-	
+	if (ctx->shared) pthread_mutex_lock(&ctx->lock);
+	void *mem = ctx_alloc(ctx, size);
+	if (ctx->shared) pthread_mutex_unlock(&ctx->lock);
+	return mem;
+}
+
+// Allocates memory belonging to a context, recording the call site for statistics.
+void *alloc_on_ctx_at(alloc_ctx_t ctx, size_t size, const char *file, int line) {
+	ALLOC_STATS(alloc_stats_site(file, line, size));
+	return alloc_on_ctx(ctx, size);
+}
+
+// Re-allocates memory belonging to a context, without locking.
+static void *ctx_realloc(alloc_ctx_t ctx, void *memory, size_t size) {
 	if (!size) {
 		// If size is zero then free instead.
-		free_on_ctx(ctx, memory);
+		ctx_free(ctx, memory);
 		return NULL;
 	} else if (!memory) {
 		// If memory is NULL then allocate instead.
-		return alloc_on_ctx(ctx, size);
+		return ctx_alloc(ctx, size);
+	}
+	
+	if (alloc_is_arena_bit(memory)) {
+		alloc_arena_bit_t *bit = (alloc_arena_bit_t *) memory - 1;
+		// Assert the bit is owned by the given context.
+		ALLOC_BIT_OWNER_ASSERT(bit, ctx);
+		size_t cap = alloc_arena_cap(bit);
+		__atomic_fetch_add(&alloc_realloc_counts.reallocs, 1, __ATOMIC_RELAXED);
+		// Shrinking or growing within the padding is free.
+		if (size <= cap) {
+			__atomic_fetch_add(&alloc_realloc_counts.in_place, 1, __ATOMIC_RELAXED);
+			return memory;
+		}
+		// The most recent allocation of an arena can grow into the rest of its block.
+		alloc_block_t *block  = bit->owner->blocks;
+		size_t         newcap = (size + 7) & ~(size_t) 7;
+		if ((size_t) memory + cap == (size_t) (block + 1) + block->used && block->cap - block->used >= newcap - cap) {
+			block->used += newcap - cap;
+			bit->cap     = newcap | ALLOC_ARENA_FLAG;
+			ALLOC_STATS(alloc_stats_resize(bit->owner, cap, memory));
+			__atomic_fetch_add(&alloc_realloc_counts.in_place, 1, __ATOMIC_RELAXED);
+			return memory;
+		}
+		// Otherwise at least double, so repeated growth by a little copies a linear amount.
+		size_t newsize = cap * 2;
+		if (newsize < size) newsize = size;
+		void *newmem = ctx_alloc(bit->owner, newsize);
+		if (!newmem) return NULL;
+		memcpy(newmem, memory, cap);
+		__atomic_fetch_add(&alloc_realloc_counts.copied, cap, __ATOMIC_RELAXED);
+		ctx_free(bit->owner, memory);
+		return newmem;
 	}
 	
 	// Magic checks.
@@ -186,6 +711,8 @@ void *realloc_on_ctx(alloc_ctx_t ctx, void *memory, size_t size) {
 	ALLOC_BIT_MAGIC_ASSERT((alloc_bit_t *) realmem);
 	// Assert the bit is owned by the given context.
 	ALLOC_BIT_OWNER_ASSERT((alloc_bit_t *) realmem, ctx);
+	size_t old_bytes = alloc_usable_size(memory);
+	__atomic_fetch_add(&alloc_realloc_counts.reallocs, 1, __ATOMIC_RELAXED);
 	// Re-allocate the memory.
 	void *newmem = realloc(realmem, size + sizeof(alloc_bit_t));
 	if (!newmem) {
@@ -194,10 +721,15 @@ void *realloc_on_ctx(alloc_ctx_t ctx, void *memory, size_t size) {
 		return NULL;
 	} else if (newmem == realmem) {
 		// No need to fix pointers.
+		__atomic_fetch_add(&alloc_realloc_counts.in_place, 1, __ATOMIC_RELAXED);
 		void *ptr = (void *) ((size_t) newmem + sizeof(alloc_bit_t));
+		ALLOC_STATS(alloc_stats_resize(((alloc_bit_t *) newmem)->owner, old_bytes, ptr));
 		return ptr;
 	}
 	
+	// Assume realloc had to copy everything that fits.
+	__atomic_fetch_add(&alloc_realloc_counts.copied, old_bytes < size ? old_bytes : size, __ATOMIC_RELAXED);
+	
 	// Fix next and prev pointers.
 	alloc_bit_t *bit = newmem;
 	ctx = bit->owner;
@@ -214,17 +746,53 @@ void *realloc_on_ctx(alloc_ctx_t ctx, void *memory, size_t size) {
 	
 	// Return usable memory.
 	void *ptr = (void *) ((size_t) newmem + sizeof(alloc_bit_t));
+	ALLOC_STATS(alloc_stats_resize(ctx, old_bytes, ptr));
 	return ptr;
 }
 
 // Re-allocates memory belonging to a context.
-void free_on_ctx(alloc_ctx_t ctx, void *memory) {
+void *realloc_on_ctx(alloc_ctx_t ctx, void *memory, size_t size) {
 	// Assert the context is valid.
 	ALLOC_CTX_MAGIC_ASSERT(ctx);
-	
+	// Existing memory is resized on its owner, which may be a shared ancestor of ctx.
+	alloc_ctx_t owner = alloc_owner_of(ctx, memory);
+	if (owner->shared) pthread_mutex_lock(&owner->lock);
+	void *mem = ctx_realloc(ctx, memory, size);
+	if (owner->shared) pthread_mutex_unlock(&owner->lock);
+	return mem;
+}
+
+// Re-allocates memory belonging to a context, recording the call site for statistics.
+void *realloc_on_ctx_at(alloc_ctx_t ctx, void *memory, size_t size, const char *file, int line) {
+	if (size) ALLOC_STATS(alloc_stats_site(file, line, size));
+	return realloc_on_ctx(ctx, memory, size);
+}
+
+// Frees memory belonging to a context, without locking.
+static void ctx_free(alloc_ctx_t ctx, void *memory) {
 	// Ignore free of null.
 	if (!memory) return;
 	
+	if (alloc_is_arena_bit(memory)) {
+		alloc_arena_bit_t *bit = (alloc_arena_bit_t *) memory - 1;
+		// Assert the bit is owned by the given context.
+		ALLOC_BIT_OWNER_ASSERT(bit, ctx);
+		size_t cap = alloc_arena_cap(bit);
+		ALLOC_STATS(alloc_stats_sub(bit->owner, cap));
+#ifdef ALLOC_CHECKED
+		// Protect against double free.
+		bit->magic = 0;
+#endif
+		ALLOC_POISON_MEMORY(memory, cap);
+		// Small memory goes back to the pool, the rest is reclaimed when the arena is cleared.
+		if (cap <= ALLOC_POOL_MAX_SIZE) {
+			ctx = bit->owner;
+			*(void **) memory = ctx->pools[cap / 8 - 1];
+			ctx->pools[cap / 8 - 1] = memory;
+		}
+		return;
+	}
+	
 	// Check magic values.
 	void *realmem = (void *) ((size_t) memory - sizeof(alloc_bit_t));
 	ALLOC_BIT_MAGIC_ASSERT((alloc_bit_t *) realmem);
@@ -232,6 +800,7 @@ void free_on_ctx(alloc_ctx_t ctx, void *memory) {
 	// Assert the bit is owned by the given context.
 	ALLOC_BIT_OWNER_ASSERT(bit, ctx);
 	ctx = bit->owner;
+	ALLOC_STATS(alloc_stats_sub(ctx, alloc_usable_size(memory)));
 	
 	// Unlink the bit.
 	if (bit->prev) {
@@ -245,10 +814,20 @@ void free_on_ctx(alloc_ctx_t ctx, void *memory) {
 		ctx->last = bit->prev;
 	}
 	
-	// Protect against double free.
-	bit->magic1 = 0;
-	bit->magic2 = 0;
+	// Poisoning also clears the magic values, protecting against double free.
+	ALLOC_POISON_MEMORY(realmem, malloc_usable_size(realmem));
 	
 	// Free the memory.
 	free(realmem);
 }
+
+// Frees memory belonging to a context.
+void free_on_ctx(alloc_ctx_t ctx, void *memory) {
+	// Assert the context is valid.
+	ALLOC_CTX_MAGIC_ASSERT(ctx);
+	// Memory is freed from its owner, which may be a shared ancestor of ctx.
+	alloc_ctx_t owner = alloc_owner_of(ctx, memory);
+	if (owner->shared) pthread_mutex_lock(&owner->lock);
+	ctx_free(ctx, memory);
+	if (owner->shared) pthread_mutex_unlock(&owner->lock);
+}
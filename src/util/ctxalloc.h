@@ -6,30 +6,85 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include <string.h>
+#include <stdio.h>
 
 #ifdef CTXALLOC_C
 
+#include <pthread.h>
+
+// Number of 8-byte size classes recycled by arena contexts.
+#define ALLOC_POOL_CLASSES 32
+
 struct alloc_bit;
+struct alloc_block;
+struct alloc_arena_bit;
+struct alloc_ctx_stats;
 struct alloc_ctx;
 
-typedef struct alloc_bit  alloc_bit_t;
+typedef struct alloc_bit       alloc_bit_t;
+typedef struct alloc_block     alloc_block_t;
+typedef struct alloc_arena_bit alloc_arena_bit_t;
+typedef struct alloc_ctx_stats alloc_ctx_stats_t;
 typedef struct alloc_ctx  alloc_ctx_s;
 typedef struct alloc_ctx *alloc_ctx_t;
 
 struct alloc_bit {
+#ifdef ALLOC_CHECKED
 	uint64_t     magic1;
+#endif
 	alloc_ctx_t  owner;
 	alloc_bit_t *prev;
 	alloc_bit_t *next;
+#ifdef ALLOC_CHECKED
 	uint64_t     magic2;
+#endif
+};
+
+// A block of memory that arena allocations are carved out of.
+struct alloc_block {
+	alloc_block_t *next;
+	size_t         cap;
+	size_t         used;
+};
+
+// Header of an allocation carved out of an arena block.
+struct alloc_arena_bit {
+	alloc_ctx_t  owner;
+	// Usable size, with the lowest bit set to tell this apart from an alloc_bit_t.
+	size_t       cap;
+#ifdef ALLOC_CHECKED
+	uint64_t     magic;
+#endif
 };
 
 struct alloc_ctx {
-	uint64_t     magic1;
-	alloc_ctx_t  parent;
-	alloc_bit_t *first;
-	alloc_bit_t *last;
-	uint64_t     magic2;
+#ifdef ALLOC_CHECKED
+	uint64_t       magic1;
+#endif
+	alloc_ctx_t    parent;
+	alloc_bit_t   *first;
+	alloc_bit_t   *last;
+	// Arena blocks, most recent first; only used by arena contexts.
+	alloc_block_t *blocks;
+	// Free lists of recycled arena allocations, one per size class.
+	void          *pools[ALLOC_POOL_CLASSES];
+	bool           arena;
+	// Where the context was created, for statistics.
+	const char    *file;
+	int            line;
+	// Statistics shared by contexts created at the same place, if enabled.
+	alloc_ctx_stats_t *stats;
+	// Bytes currently allocated, if statistics are enabled.
+	size_t         live;
+	// Contexts handed off to this one, pushed without locking.
+	alloc_ctx_t    adopted;
+	alloc_ctx_t    next_adopted;
+	// Whether the context can be used from multiple threads, through the lock.
+	bool           shared;
+	pthread_mutex_t lock;
+#ifdef ALLOC_CHECKED
+	uint64_t       magic2;
+#endif
 };
 
 #else //CTXALLOC_C
@@ -45,8 +100,23 @@ extern alloc_ctx_t global_alloc;
 // Initialises the alloc system thingy.
 void        alloc_init    ();
 
+// Only global_alloc may be used from multiple threads at once.
+// Other contexts belong to one thread at a time, and can be handed back to their parent with alloc_handoff.
+
+// Hands a context over to its parent, which destroys it when cleared.
+// Memory on the context stays valid; safe to call concurrently for contexts with the same parent.
+void        alloc_handoff (alloc_ctx_t ctx);
+// Hands a context over to another context, which destroys it when cleared.
+// Memory on the context stays valid; safe to call concurrently for the same parent.
+void        alloc_handoff_to(alloc_ctx_t parent, alloc_ctx_t ctx);
+// Frees the arena blocks cached by the calling thread; call before an allocating thread exits.
+void        alloc_thread_cleanup();
+
 // Creates a new memory allocation context.
 alloc_ctx_t alloc_create  (alloc_ctx_t parent);
+// Creates a new memory allocation context which carves small allocations out of large blocks.
+// Freed allocations of up to 256 bytes are pooled for reuse, the rest is reclaimed when the context is cleared.
+alloc_ctx_t alloc_create_arena(alloc_ctx_t parent);
 // Frees all memory of the context, recursively.
 void        alloc_clear   (alloc_ctx_t ctx);
 // Frees all memory of the context and destroys the context.
@@ -59,26 +129,52 @@ void       *realloc_on_ctx(alloc_ctx_t ctx, void  *memory, size_t size);
 // Frees memory belonging to a context.
 void        free_on_ctx   (alloc_ctx_t ctx, void  *memory);
 
+// Creates a new memory allocation context, recording the call site for statistics.
+alloc_ctx_t alloc_create_at   (alloc_ctx_t parent, bool arena, const char *file, int line);
+// Allocates memory belonging to a context, recording the call site for statistics.
+void       *alloc_on_ctx_at   (alloc_ctx_t ctx, size_t size, const char *file, int line);
+// Re-allocates memory belonging to a context, recording the call site for statistics.
+void       *realloc_on_ctx_at (alloc_ctx_t ctx, void *memory, size_t size, const char *file, int line);
+
+// Re-allocation counters.
+typedef struct {
+	// Number of re-allocations.
+	size_t reallocs;
+	// Number of re-allocations that did not move the memory.
+	size_t in_place;
+	// Number of bytes copied by re-allocations that did.
+	size_t copied;
+} xrealloc_stats_t;
+
+// Gets the re-allocation counters since startup.
+xrealloc_stats_t xrealloc_stats();
+// Starts recording allocation statistics.
+void        alloc_stats_enable();
+// Prints the contexts and allocation sites that used the most memory.
+void        alloc_stats_report(FILE *fd);
+
 #ifndef CTXALLOC_C
 
-// Allocates memory belonging to a context.
-static inline void *xalloc(alloc_ctx_t ctx, size_t size) {
-	return alloc_on_ctx(ctx, size);
-}
+// Creates a new memory allocation context.
+#define alloc_create(parent)        alloc_create_at(parent, false, __FILE__, __LINE__)
+// Creates a new memory allocation context which carves small allocations out of large blocks.
+#define alloc_create_arena(parent)  alloc_create_at(parent, true,  __FILE__, __LINE__)
 
+// Allocates memory belonging to a context.
+#define xalloc(ctx, size)           alloc_on_ctx_at(ctx, size, __FILE__, __LINE__)
 // Re-allocates memory belonging to a context.
-static inline void *xrealloc(alloc_ctx_t ctx, void *memory, size_t size) {
-	return realloc_on_ctx(ctx, memory, size);
-}
+#define xrealloc(ctx, memory, size) realloc_on_ctx_at(ctx, memory, size, __FILE__, __LINE__)
+// Strdup but with an allocator.
+#define xstrdup(ctx, memory)        xstrdup_at(ctx, memory, __FILE__, __LINE__)
 
 // Frees memory belonging to a context.
 static inline void xfree(alloc_ctx_t ctx, void *memory) {
 	free_on_ctx(ctx, memory);
 }
 
-// Strdup but with an allocator.
-static inline char *xstrdup(alloc_ctx_t ctx, const char *memory) {
-	char *newmem = alloc_on_ctx(ctx, strlen(memory) + 1);
+// Strdup but with an allocator, recording the call site for statistics.
+static inline char *xstrdup_at(alloc_ctx_t ctx, const char *memory, const char *file, int line) {
+	char *newmem = alloc_on_ctx_at(ctx, strlen(memory) + 1, file, line);
 	strcpy(newmem, memory);
 	return newmem;
 }
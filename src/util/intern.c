@@ -0,0 +1,167 @@
+
+#include "intern.h"
+#include <malloc.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Header stored right in front of each interned string.
+typedef struct {
+	uint32_t len;
+	uint32_t id;
+} intern_hdr_t;
+
+// Slot in the hash table.
+typedef struct {
+	// Hash of the string, only valid if str is set.
+	uint32_t    hash;
+	// The interned string, or NULL if the slot is empty.
+	const char *str;
+} intern_slot_t;
+
+#define INTERN_BLOCK_SIZE 16384
+#define INTERN_DEFAULT_CAPACITY 256
+
+// Open addressing hash table, capacity is always a power of two.
+static intern_slot_t *slots;
+static size_t         slots_cap;
+// Interned strings by id.
+static const char   **by_id;
+static size_t         by_id_len;
+static size_t         by_id_cap;
+// Block the next string is copied into.
+static char          *block;
+static size_t         block_left;
+// Guards all of the above, so multiple frontends can intern at once.
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+// FNV-1a hash of the first len characters of str, as used by the intern table.
+uint32_t intern_hash(const char *str, size_t len) {
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ (uint8_t) str[i]) * 16777619u;
+	}
+	return hash;
+}
+
+// Gets the header of an interned string.
+static inline intern_hdr_t *intern_hdr(const char *interned) {
+	return (intern_hdr_t *) interned - 1;
+}
+
+// Finds the slot for a string: either the one holding it, or the empty one it would go in.
+static intern_slot_t *intern_lkup(const char *str, size_t len, uint32_t hash) {
+	size_t mask = slots_cap - 1;
+	for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+		intern_slot_t *slot = &slots[i];
+		if (!slot->str) return slot;
+		if (slot->hash == hash && intern_hdr(slot->str)->len == len && !memcmp(slot->str, str, len)) {
+			return slot;
+		}
+	}
+}
+
+// Doubles the size of the hash table.
+static void intern_grow() {
+	intern_slot_t *old     = slots;
+	size_t         old_cap = slots_cap;
+	slots_cap = old_cap ? old_cap * 2 : INTERN_DEFAULT_CAPACITY;
+	slots     = calloc(slots_cap, sizeof(intern_slot_t));
+	if (!slots) {printf("Out of memory\n"); abort();}
+	for (size_t i = 0; i < old_cap; i++) {
+		if (!old[i].str) continue;
+		*intern_lkup(old[i].str, intern_hdr(old[i].str)->len, old[i].hash) = old[i];
+	}
+	free(old);
+}
+
+// Copies a string into string storage, with a header in front.
+static const char *intern_store(const char *str, size_t len) {
+	// Round up to keep headers aligned.
+	size_t size = (sizeof(intern_hdr_t) + len + 1 + sizeof(intern_hdr_t) - 1) & ~(sizeof(intern_hdr_t) - 1);
+	char *mem;
+	if (size > INTERN_BLOCK_SIZE / 4) {
+		// Big strings get their own allocation.
+		mem = malloc(size);
+	} else {
+		if (size > block_left) {
+			block      = malloc(INTERN_BLOCK_SIZE);
+			block_left = INTERN_BLOCK_SIZE;
+		}
+		mem         = block;
+		block      += size;
+		block_left -= size;
+	}
+	if (!mem) {printf("Out of memory\n"); abort();}
+	
+	intern_hdr_t *hdr = (intern_hdr_t *) mem;
+	char *copy = (char *) (hdr + 1);
+	hdr->len = len;
+	hdr->id  = by_id_len;
+	memcpy(copy, str, len);
+	copy[len] = 0;
+	
+	// Record the id.
+	if (by_id_len >= by_id_cap) {
+		by_id_cap = by_id_cap ? by_id_cap * 2 : INTERN_DEFAULT_CAPACITY;
+		by_id     = realloc(by_id, sizeof(const char *) * by_id_cap);
+		if (!by_id) {printf("Out of memory\n"); abort();}
+	}
+	by_id[by_id_len++] = copy;
+	
+	return copy;
+}
+
+// Returns the interned copy of str.
+const char *intern(const char *str) {
+	return intern_n(str, strlen(str));
+}
+
+// Returns the interned copy of the first len characters of str.
+const char *intern_n(const char *str, size_t len) {
+	uint32_t hash = intern_hash(str, len);
+	pthread_mutex_lock(&lock);
+	
+	// Keep the load factor under 3/4.
+	if ((by_id_len + 1) * 4 > slots_cap * 3) intern_grow();
+	
+	intern_slot_t *slot = intern_lkup(str, len, hash);
+	if (!slot->str) {
+		slot->hash = hash;
+		slot->str  = intern_store(str, len);
+	}
+	const char *interned = slot->str;
+	
+	pthread_mutex_unlock(&lock);
+	return interned;
+}
+
+// Returns the interned copy of str if it has been interned, NULL otherwise.
+const char *intern_find(const char *str) {
+	size_t   len  = strlen(str);
+	uint32_t hash = intern_hash(str, len);
+	pthread_mutex_lock(&lock);
+	const char *interned = slots_cap ? intern_lkup(str, len, hash)->str : NULL;
+	pthread_mutex_unlock(&lock);
+	return interned;
+}
+
+// Returns the id of an interned string.
+// Ids are handed out from 0 upwards in order of interning.
+uint32_t intern_id(const char *interned) {
+	return intern_hdr(interned)->id;
+}
+
+// Returns the interned string with the given id.
+const char *intern_get(uint32_t id) {
+	pthread_mutex_lock(&lock);
+	const char *interned = id < by_id_len ? by_id[id] : NULL;
+	pthread_mutex_unlock(&lock);
+	return interned;
+}
+
+// Returns the number of distinct strings interned.
+size_t intern_count() {
+	return by_id_len;
+}
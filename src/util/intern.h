@@ -0,0 +1,28 @@
+
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Interned strings are unique by content and live until the program exits.
+// Two interned strings are equal if and only if their pointers are equal.
+
+// Returns the interned copy of str.
+const char *intern        (const char *str);
+// Returns the interned copy of the first len characters of str.
+const char *intern_n      (const char *str, size_t len);
+// Returns the interned copy of str if it has been interned, NULL otherwise.
+const char *intern_find   (const char *str);
+// Returns the id of an interned string.
+// Ids are handed out from 0 upwards in order of interning.
+uint32_t    intern_id     (const char *interned);
+// Returns the interned string with the given id.
+const char *intern_get    (uint32_t id);
+// Returns the number of distinct strings interned.
+size_t      intern_count  ();
+// FNV-1a hash of the first len characters of str, as used by the intern table.
+uint32_t    intern_hash   (const char *str, size_t len);
+
+#endif // INTERN_H
@@ -1,22 +1,36 @@
 
 #include <strmap.h>
-#include <malloc.h>
+#include <intern.h>
+#include <ctxalloc.h>
+#include <stdlib.h>
 #include <string.h>
 
 // Creates an empty map.
 void map_create(map_t *map) {
 	map->numEntries = 0;
 	map->capacity = MAP_DEFAULT_CAPACITY;
-	map->strings = (char **) malloc(sizeof(char *) * map->capacity);
-	map->values = (const void **) malloc(sizeof(void *) * map->capacity);
+	map->strings = (char **) xalloc(global_alloc, sizeof(char *) * map->capacity);
+	map->values = (const void **) xalloc(global_alloc, sizeof(void *) * map->capacity);
+	map->index = NULL;
+	map->indexCap = 0;
+	map->byContent = false;
+}
+
+// Creates an empty map whose keys are compared by content and are not interned.
+void map_create_by_content(map_t *map) {
+	map_create(map);
+	map->byContent = true;
 }
 
 // Deletes a map.
 void map_delete(map_t *map) {
 	map->numEntries = 0;
 	map->capacity = 0;
-	free(map->strings);
-	free(map->values);
+	xfree(global_alloc, map->strings);
+	xfree(global_alloc, map->values);
+	if (map->index) xfree(global_alloc, map->index);
+	map->index = NULL;
+	map->indexCap = 0;
 }
 
 // Deletes a map and every value.
@@ -27,11 +41,74 @@ void map_delete_with_values(map_t *map) {
 	map_delete(map);
 }
 
-// Finds key in map.
+// Hashes a key by its content or, if it is interned, by its address.
+static inline size_t map_hash(map_t *map, const char *key) {
+	if (map->byContent) return intern_hash(key, strlen(key));
+	return (size_t) (((uint64_t) (size_t) key * 0x9e3779b97f4a7c15llu) >> 32);
+}
+
+// Tests whether a key is the same as that of an entry.
+static inline bool map_key_equals(map_t *map, const char *key, const char *entry) {
+	return key == entry || (map->byContent && !strcmp(key, entry));
+}
+
+// Finds the index slot of an entry number.
+static inline size_t map_slot_of(map_t *map, size_t i) {
+	size_t mask = map->indexCap - 1;
+	size_t slot = map_hash(map, map->strings[i]) & mask;
+	while (map->index[slot] != i + 1) slot = (slot + 1) & mask;
+	return slot;
+}
+
+// Adds an entry number to the index.
+static inline void map_index_add(map_t *map, size_t i) {
+	size_t mask = map->indexCap - 1;
+	size_t slot = map_hash(map, map->strings[i]) & mask;
+	while (map->index[slot]) slot = (slot + 1) & mask;
+	map->index[slot] = i + 1;
+}
+
+// Removes an index slot, shifting back the entries that probed past it.
+static void map_index_remove(map_t *map, size_t hole) {
+	size_t mask = map->indexCap - 1;
+	for (size_t slot = (hole + 1) & mask; map->index[slot]; slot = (slot + 1) & mask) {
+		size_t home = map_hash(map, map->strings[map->index[slot] - 1]) & mask;
+		// Entries whose home lies cyclically in (hole, slot] stay where they are.
+		if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+			map->index[hole] = map->index[slot];
+			hole = slot;
+		}
+	}
+	map->index[hole] = 0;
+}
+
+// Rebuilds the index to have twice as many slots as the map has capacity.
+static void map_reindex(map_t *map) {
+	if (map->index) xfree(global_alloc, map->index);
+	map->indexCap = map->capacity * 2;
+	map->index = xalloc(global_alloc, sizeof(uint32_t) * map->indexCap);
+	memset(map->index, 0, sizeof(uint32_t) * map->indexCap);
+	for (size_t i = 0; i < map->numEntries; i++) {
+		map_index_add(map, i);
+	}
+}
+
+// Finds key in map, which must be interned unless the map compares by content.
 // Returns -1 if not found.
 static inline int map_lkup(map_t *map, const char *key) {
-	for (int i = 0; i < map->numEntries; i++) {
-		if (!strcmp(map->strings[i], key)) {
+	if (!map->index) {
+		// Small maps are faster to search without hashing.
+		for (int i = 0; i < map->numEntries; i++) {
+			if (map_key_equals(map, key, map->strings[i])) {
+				return i;
+			}
+		}
+		return -1;
+	}
+	size_t mask = map->indexCap - 1;
+	for (size_t slot = map_hash(map, key) & mask; map->index[slot]; slot = (slot + 1) & mask) {
+		int i = map->index[slot] - 1;
+		if (map_key_equals(map, key, map->strings[i])) {
 			return i;
 		}
 	}
@@ -41,6 +118,16 @@ static inline int map_lkup(map_t *map, const char *key) {
 // Gets key from map.
 // Returns null if no such key.
 void *map_get(map_t *map, const char *key) {
+	if (map->byContent) return map_get_interned(map, key);
+	// Keys are interned, so a string that never was can't be in any map.
+	const char *interned = intern_find(key);
+	if (!interned) return NULL;
+	return map_get_interned(map, interned);
+}
+
+// Gets interned key from map, without looking it up in the intern table.
+// Returns null if no such key.
+void *map_get_interned(map_t *map, const char *key) {
 	int i = map_lkup(map, key);
 	if (i >= 0) {
 		return (void *) map->values[i];
@@ -52,10 +139,18 @@ void *map_get(map_t *map, const char *key) {
 // Puts val in map at key.
 // Providing null for val removes the item.
 // Returns null or replaced item.
-// Will copy the provided string.
+// Will intern the provided string.
 // Will NOT copy the provided item.
 void *map_set(map_t *map, const char *key, const void *val) {
 	if (!val) return map_remove(map, key);
+	return map_set_interned(map, map->byContent ? key : intern(key), val);
+}
+
+// Puts val in map at interned key, which is used as-is.
+// Providing null for val removes the item.
+// Returns null or replaced item.
+void *map_set_interned(map_t *map, const char *key, const void *val) {
+	if (!val) return map_remove_interned(map, key);
 	int i = map_lkup(map, key);
 	if (i >= 0) {
 		void *ret = (void *) map->values[i];
@@ -63,12 +158,14 @@ void *map_set(map_t *map, const char *key, const void *val) {
 		return ret;
 	} else {
 		if (map->numEntries >= map->capacity) {
-			map->capacity += MAP_CAPACITY_INCREMENT;
-			map->strings = realloc(map->strings, sizeof(char *) * map->capacity);
-			map->values = realloc(map->values, sizeof(void *) * map->capacity);
+			map->capacity *= 2;
+			map->strings = xrealloc(global_alloc, map->strings, sizeof(char *) * map->capacity);
+			map->values = xrealloc(global_alloc, map->values, sizeof(void *) * map->capacity);
+			if (map->capacity > MAP_INDEX_THRESHOLD) map_reindex(map);
 		}
-		map->strings[map->numEntries] = strdup(key);
+		map->strings[map->numEntries] = (char *) key;
 		map->values[map->numEntries] = val;
+		if (map->index) map_index_add(map, map->numEntries);
 		map->numEntries ++;
 		return NULL;
 	}
@@ -77,12 +174,23 @@ void *map_set(map_t *map, const char *key, const void *val) {
 // Removes key from map.
 // Returns null or removed item.
 void *map_remove(map_t *map, const char *key) {
+	if (map->byContent) return map_remove_interned(map, key);
+	const char *interned = intern_find(key);
+	if (!interned) return NULL;
+	return map_remove_interned(map, interned);
+}
+
+// Removes interned key from map.
+// Returns null or removed item.
+void *map_remove_interned(map_t *map, const char *key) {
 	int i = map_lkup(map, key);
 	if (i >= 0) {
-		free(map->strings[i]);
 		void *ret = (void *) map->values[i];
+		if (map->index) map_index_remove(map, map_slot_of(map, i));
 		map->numEntries --;
 		if (i != map->numEntries) {
+			// The last entry takes the place of the removed one.
+			if (map->index) map->index[map_slot_of(map, map->numEntries)] = i + 1;
 			map->strings[i] = map->strings[map->numEntries];
 			map->values[i] = map->values[map->numEntries];
 		}
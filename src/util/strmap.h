@@ -4,20 +4,34 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 
 typedef struct map {
 	size_t numEntries;
 	size_t capacity;
+	// Keys, interned so they can be compared by pointer.
+	// Maps created by map_create_by_content use the caller's keys as-is instead.
 	char **strings;
 	const void **values;
+	// Open-addressing hash index of entry number plus one, NULL while the map is small.
+	uint32_t *index;
+	// Number of slots in the index, a power of two.
+	size_t indexCap;
+	// Whether keys are compared by content instead of by pointer.
+	bool byContent;
 } map_t;
 
 #define MAP_DEFAULT_CAPACITY 4
-#define MAP_CAPACITY_INCREMENT 4
+// Maps with at most this many entries are searched without the index.
+#define MAP_INDEX_THRESHOLD 8
 
 // Creates an empty map.
 void map_create(map_t *map);
 
+// Creates an empty map whose keys are compared by content and are not interned.
+// The caller owns the keys and must keep them alive for as long as they are in the map.
+void map_create_by_content(map_t *map);
+
 // Deletes a map.
 void map_delete(map_t *map);
 
@@ -31,13 +45,29 @@ void *map_get(map_t *map, const char *key);
 // Puts val in map at key.
 // Providing null for val removes the item.
 // Returns null or replaced item.
-// Does not copy the provided item.
+// Interns the key, but does not copy the provided item.
 void *map_set(map_t *map, const char *key, const void *val);
 
 // Removes key from map.
 // Returns null or removed item.
 void *map_remove(map_t *map, const char *key);
 
+// Variants of the above for keys that are already interned.
+// These skip the intern table, so they are cheaper when the same key is used repeatedly.
+
+// Gets interned key from map.
+// Returns null if no such key.
+void *map_get_interned(map_t *map, const char *key);
+
+// Puts val in map at interned key, which is used as-is.
+// Providing null for val removes the item.
+// Returns null or replaced item.
+void *map_set_interned(map_t *map, const char *key, const void *val);
+
+// Removes interned key from map.
+// Returns null or removed item.
+void *map_remove_interned(map_t *map, const char *key);
+
 // Dumps the map for debug purposes.
 void map_dump(map_t *map);
 